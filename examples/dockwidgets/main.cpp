@@ -115,6 +115,10 @@ int main(int argc, char **argv)
                                            QCoreApplication::translate("main", "The title bar's close button will only close the current tab instead of all. Illustrates using Config::Flag_CloseOnlyCurrentTab"));
     parser.addOption(closeOnlyCurrentTab);
 
+    QCommandLineOption coalescedResizeOption("coalesced-resize",
+                                             QCoreApplication::translate("main", "Dragging a separator resizes at most once per frame. Illustrates Config::Flag_CoalescedResize"));
+    parser.addOption(coalescedResizeOption);
+
     QCommandLineOption dontCloseBeforeRestore("dont-close-widget-before-restore", //krazy:exclude=spelling
                                               QCoreApplication::translate("main", "DockWidget #5 wont be closed before a restore. Illustrates LayoutSaverOption::DontCloseBeforeRestore"));
     parser.addOption(dontCloseBeforeRestore);
@@ -220,6 +224,9 @@ int main(int argc, char **argv)
     if (parser.isSet(lazyResizeOption))
         flags |= KDDockWidgets::Config::Flag_LazyResize;
 
+    if (parser.isSet(coalescedResizeOption))
+        flags |= KDDockWidgets::Config::Flag_CoalescedResize;
+
     if (parser.isSet(tabsHaveCloseButton))
         flags |= KDDockWidgets::Config::Flag_TabsHaveCloseButton;
 
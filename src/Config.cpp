@@ -61,6 +61,8 @@ public:
     CustomizableWidgets m_disabledPaintEvents = CustomizableWidget_None;
     qreal m_draggedWindowOpacity = Q_QNAN;
     int m_mdiPopupThreshold = 250;
+    int m_maxPlaceholdersPerLayout = 0;
+    int m_maxPlaceholderAge = 0;
     bool m_dropIndicatorsInhibited = false;
 #ifdef KDDOCKWIDGETS_QTQUICK
     QtQuickHelpers m_qquickHelpers;
@@ -111,6 +113,8 @@ void Config::setFlags(Flags f)
 
     auto multisplitterFlags = Layouting::Config::self().flags();
     multisplitterFlags.setFlag(Layouting::Config::Flag::LazyResize, d->m_flags & Flag_LazyResize);
+    multisplitterFlags.setFlag(Layouting::Config::Flag::CoalescedResize, d->m_flags & Flag_CoalescedResize);
+    multisplitterFlags.setFlag(Layouting::Config::Flag::CoalescedSizeConstraints, d->m_flags & Flag_CoalescedSizeConstraints);
     Layouting::Config::self().setFlags(multisplitterFlags);
 }
 
@@ -327,6 +331,26 @@ int Config::mdiPopupThreshold() const
     return d->m_mdiPopupThreshold;
 }
 
+void Config::setMaxPlaceholdersPerLayout(int count)
+{
+    d->m_maxPlaceholdersPerLayout = count;
+}
+
+int Config::maxPlaceholdersPerLayout() const
+{
+    return d->m_maxPlaceholdersPerLayout;
+}
+
+void Config::setMaxPlaceholderAge(int msecs)
+{
+    d->m_maxPlaceholderAge = msecs;
+}
+
+int Config::maxPlaceholderAge() const
+{
+    return d->m_maxPlaceholderAge;
+}
+
 void Config::setDropIndicatorsInhibited(bool inhibit) const
 {
     if (d->m_dropIndicatorsInhibited != inhibit) {
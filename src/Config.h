@@ -81,6 +81,11 @@ public:
                                                                     ///< By default it also turns off the float button, but you can remove Flag_TitleBarNoFloatButton to have both.
         Flag_KeepAboveIfNotUtilityWindow = 0x10000, ///< Only meaningful if Flag_DontUseUtilityFloatingWindows is set. If floating windows are normal windows, you might still want them to keep above and not minimize when you focus the main window.
         Flag_CloseOnlyCurrentTab = 0x20000, ///< The TitleBar's close button will only close the current tab, instead of all of them
+        Flag_CoalescedResize = 0x40000, ///< Dragging a separator resizes the dock widgets at most once per frame, using only the latest mouse position. Intermediate steps are dropped when resizing takes longer than a frame. Ignored if Flag_LazyResize is set.
+        Flag_SuspendHiddenDockWidgets = 0x80000, ///< Dock widgets nobody can see (non-current tabs, closed, or minimized to a side-bar) stop repainting their guest widget. See DockWidgetBase::isSuspended()
+        Flag_TabOverflowMenu = 0x100000, ///< When tabs don't fit, a button next to the tab bar shows a menu with all of them. Useful for frames with many tabs. QtWidgets only, QtQuick's tab bar is already a scrollable list.
+        Flag_CompactPlaceholdersOnSave = 0x200000, ///< The limits set with setMaxPlaceholdersPerLayout() and setMaxPlaceholderAge() are only applied when saving the layout, instead of whenever a dock widget closes
+        Flag_CoalescedSizeConstraints = 0x400000, ///< When dock widgets change their min or max size, the layout is updated once on the next event loop iteration, for all of them, instead of once per dock widget. Useful when many change at once, for example after a font or style change.
         Flag_Default = Flag_AeroSnapWithClientDecos ///< The defaults
     };
     Q_DECLARE_FLAGS(Flags, Flag)
@@ -253,6 +258,20 @@ public:
     void setMDIPopupThreshold(int);
     int mdiPopupThreshold() const;
 
+    /// @brief Sets how many placeholders each layout keeps at most.
+    /// Placeholders remember where closed dock widgets were, so they can be restored there.
+    /// When there are more, the oldest ones are removed and their dock widgets restore as a tab of
+    /// a neighbour instead. By default there's no limit (0).
+    /// @sa setMaxPlaceholderAge(), Flag_CompactPlaceholdersOnSave
+    void setMaxPlaceholdersPerLayout(int count);
+    int maxPlaceholdersPerLayout() const;
+
+    /// @brief Placeholders whose dock widgets have been closed for longer than @p msecs are removed.
+    /// By default there's no limit (0).
+    /// @sa setMaxPlaceholdersPerLayout()
+    void setMaxPlaceholderAge(int msecs);
+    int maxPlaceholderAge() const;
+
 #ifdef KDDOCKWIDGETS_QTQUICK
     ///@brief Sets the QQmlEngine to use. Applicable only when using QtQuick.
     void setQmlEngine(QQmlEngine *);
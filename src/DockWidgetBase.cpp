@@ -71,7 +71,7 @@ void DockWidgetBase::addDockWidgetAsTab(DockWidgetBase *other, InitialOption opt
         return;
     }
 
-    if (!DockRegistry::self()->affinitiesMatch(other->affinities(), d->affinities)) {
+    if (!d->affinityMask.matches(other->d->affinityMask)) {
         qWarning() << Q_FUNC_INFO << "Refusing to dock widget with incompatible affinity."
                    << other->affinities() << affinities();
         return;
@@ -117,7 +117,7 @@ void DockWidgetBase::addDockWidgetToContainingWindow(DockWidgetBase *other,
         return;
     }
 
-    if (!DockRegistry::self()->affinitiesMatch(other->affinities(), d->affinities)) {
+    if (!d->affinityMask.matches(other->d->affinityMask)) {
         qWarning() << Q_FUNC_INFO << "Refusing to dock widget with incompatible affinity."
                    << other->affinities() << affinities();
         return;
@@ -146,12 +146,17 @@ void DockWidgetBase::setWidget(QWidgetOrQuick *w)
 
     if (d->widget) {
         // Unparent the old widget, we're giving back ownership
+        if (d->m_isSuspended)
+            d->applySuspendedState(d->widget, false);
         d->widget->setParent(nullptr);
     }
 
     d->widget = w;
-    if (w)
+    if (w) {
         setSizePolicy(w->sizePolicy());
+        if (d->m_isSuspended)
+            d->applySuspendedState(w, true);
+    }
 
     Q_EMIT widgetChanged(w);
 }
@@ -213,12 +218,12 @@ bool DockWidgetBase::setFloating(bool floats)
 
 QAction *DockWidgetBase::toggleAction() const
 {
-    return d->toggleAction;
+    return d->toggleAction();
 }
 
 QAction *DockWidgetBase::floatAction() const
 {
-    return d->floatAction;
+    return d->floatAction();
 }
 
 QString DockWidgetBase::uniqueName() const
@@ -316,8 +321,11 @@ void DockWidgetBase::setIcon(const QIcon &icon, IconPlaces places)
     if (places & IconPlace::TabBar)
         d->tabBarIcon = icon;
 
-    if (places & IconPlace::ToggleAction)
-        d->toggleAction->setIcon(icon);
+    if (places & IconPlace::ToggleAction) {
+        d->m_toggleActionIcon = icon;
+        if (d->m_toggleAction)
+            d->m_toggleAction->setIcon(icon);
+    }
 
     Q_EMIT iconChanged();
 }
@@ -331,7 +339,7 @@ QIcon DockWidgetBase::icon(IconPlace place) const
         return d->tabBarIcon;
 
     if (place == IconPlace::ToggleAction)
-        return d->toggleAction->icon();
+        return d->m_toggleActionIcon;
 
     return {};
 }
@@ -349,9 +357,14 @@ TitleBar *DockWidgetBase::titleBar() const
     return nullptr;
 }
 
+bool DockWidgetBase::isSuspended() const
+{
+    return d->m_isSuspended;
+}
+
 bool DockWidgetBase::isOpen() const
 {
-    return d->toggleAction->isChecked();
+    return d->m_isOpen;
 }
 
 QStringList DockWidgetBase::affinities() const
@@ -428,6 +441,7 @@ void DockWidgetBase::setAffinities(const QStringList &affinityNames)
     }
 
     d->affinities = affinities;
+    d->affinityMask = AffinityMask(affinities);
 }
 
 void DockWidgetBase::moveToSideBar()
@@ -501,9 +515,9 @@ FloatingWindow *DockWidgetBase::Private::morphIntoFloatingWindow()
             }
         }
 
-        auto frame = Config::self().frameworkWidgetFactory()->createFrame();
+        auto frame = Config::self().frameworkWidgetFactory()->acquireFrame();
         frame->addWidget(q);
-        auto floatingWindow = Config::self().frameworkWidgetFactory()->createFloatingWindow(frame);
+        auto floatingWindow = Config::self().frameworkWidgetFactory()->acquireFloatingWindow(frame);
         floatingWindow->setSuggestedGeometry(geo);
         floatingWindow->show();
 
@@ -543,22 +557,18 @@ QPoint DockWidgetBase::Private::defaultCenterPosForFloating()
     return mw->geometry().center();
 }
 
-bool DockWidgetBase::Private::eventFilter(QObject *watched, QEvent *event)
-{
-    const bool isWindowActivate = event->type() == QEvent::WindowActivate;
-    const bool isWindowDeactivate = event->type() == QEvent::WindowDeactivate;
-    if ((isWindowActivate || isWindowDeactivate) && watched == q->window())
-        Q_EMIT q->windowActiveAboutToChange(isWindowActivate);
-
-    return QObject::eventFilter(watched, event);
-}
-
 void DockWidgetBase::Private::updateTitle()
 {
-    if (q->isFloating())
-        q->window()->setWindowTitle(title);
+    if (q->isWindow()) {
+        // Not morphed into a FloatingWindow yet, there's no frame to do it for us
+        q->setWindowTitle(title);
+    } else if (Frame *frame = this->frame()) {
+        // Coalesced, and also updates the FloatingWindow we're in, if any
+        frame->scheduleUpdateTitleAndIcon();
+    }
 
-    toggleAction->setText(title);
+    if (m_toggleAction)
+        m_toggleAction->setText(title);
 }
 
 void DockWidgetBase::Private::toggle(bool enabled)
@@ -580,10 +590,11 @@ void DockWidgetBase::Private::updateToggleAction()
 {
     QScopedValueRollback<bool> recursionGuard(m_updatingToggleAction, true); // Guard against recursiveness
     m_updatingToggleAction = true;
-    if ((q->isVisible() || frame()) && !toggleAction->isChecked()) {
-        toggleAction->setChecked(true);
-    } else if ((!q->isVisible() && !frame()) && toggleAction->isChecked()) {
-        toggleAction->setChecked(false);
+    const bool isOpen = q->isVisible() || frame();
+    if (isOpen != m_isOpen) {
+        m_isOpen = isOpen;
+        if (m_toggleAction)
+            m_toggleAction->setChecked(isOpen);
     }
 }
 
@@ -591,14 +602,88 @@ void DockWidgetBase::Private::updateFloatAction()
 {
     QScopedValueRollback<bool> recursionGuard(m_updatingFloatAction, true); // Guard against recursiveness
 
-    if (q->isFloating()) {
-        floatAction->setEnabled(m_lastPositions.isValid());
-        floatAction->setChecked(true);
-        floatAction->setToolTip(tr("Dock"));
-    } else {
-        floatAction->setEnabled(true);
-        floatAction->setChecked(false);
-        floatAction->setToolTip(tr("Detach"));
+    const bool isFloating = q->isFloating();
+    if (m_floatAction) {
+        if (isFloating) {
+            m_floatAction->setEnabled(m_lastPositions.isValid());
+            m_floatAction->setChecked(true);
+            m_floatAction->setToolTip(tr("Dock"));
+        } else {
+            m_floatAction->setEnabled(true);
+            m_floatAction->setChecked(false);
+            m_floatAction->setToolTip(tr("Detach"));
+        }
+    }
+
+    // Already done by the action's toggled signal if it exists, does nothing then
+    onFloatingChecked(isFloating);
+}
+
+QAction *DockWidgetBase::Private::toggleAction()
+{
+    if (m_toggleAction)
+        return m_toggleAction;
+
+    m_toggleAction = new QAction(q);
+    m_toggleAction->setCheckable(true);
+    m_toggleAction->setChecked(m_isOpen);
+    m_toggleAction->setText(title);
+    m_toggleAction->setIcon(m_toggleActionIcon);
+
+    q->connect(m_toggleAction, &QAction::toggled, q, [this](bool enabled) {
+        if (!m_updatingToggleAction) { // guard against recursiveness
+            m_isOpen = enabled;
+            m_toggleAction->blockSignals(true); // and don't emit spurious toggle. Like when a dock
+                                                // widget is inserted into a tab widget it might get
+                                                // hide events, ignore those. The Dock Widget is open.
+            m_processingToggleAction = true;
+            toggle(enabled);
+            m_toggleAction->blockSignals(false);
+            m_processingToggleAction = false;
+        }
+    });
+
+    return m_toggleAction;
+}
+
+QAction *DockWidgetBase::Private::floatAction()
+{
+    if (m_floatAction)
+        return m_floatAction;
+
+    m_floatAction = new QAction(q);
+    m_floatAction->setCheckable(true);
+
+    q->connect(m_floatAction, &QAction::toggled, q, [this](bool checked) {
+        if (m_updatingFloatAction) { // guard against recursiveness
+            onFloatingChecked(checked);
+        } else {
+            q->setFloating(checked);
+            // Sync with whatever setFloating() managed to do
+            updateFloatAction();
+        }
+    });
+
+    // Sets the checked, enabled and tooltip state
+    updateFloatAction();
+
+    return m_floatAction;
+}
+
+void DockWidgetBase::Private::onFloatingChecked(bool checked)
+{
+    if (checked == m_isFloatingChecked)
+        return;
+
+    m_isFloatingChecked = checked;
+    Q_EMIT q->isFloatingChanged(checked);
+
+    // When floating, we remove from the sidebar
+    if (checked && q->isOpen()) {
+        if (SideBar *sb = DockRegistry::self()->sideBarForDockWidget(q)) {
+            sb->mainWindow()->clearSideBarOverlay(/* deleteFrame=*/false);
+            sb->removeDockWidget(q);
+        }
     }
 }
 
@@ -606,12 +691,62 @@ void DockWidgetBase::Private::onDockWidgetShown()
 {
     updateToggleAction();
     updateFloatAction();
+    updateSuspended();
 }
 
 void DockWidgetBase::Private::onDockWidgetHidden()
 {
     updateToggleAction();
     updateFloatAction();
+    updateSuspended();
+}
+
+void DockWidgetBase::Private::updateSuspended()
+{
+    // Spontaneous hides, like minimizing the window, don't count. Qt already stops painting then.
+    bool suspended = !q->isOpen() || !q->isVisible();
+    if (!suspended) {
+        // QtQuick doesn't hide the non-current tabs
+        if (Frame *frame = this->frame())
+            suspended = frame->currentDockWidget() != q;
+    }
+
+    if (suspended == m_isSuspended)
+        return;
+
+    m_isSuspended = suspended;
+    applySuspendedState(widget, suspended);
+    Q_EMIT q->isSuspendedChanged(suspended);
+}
+
+void DockWidgetBase::Private::applySuspendedState(QWidgetOrQuick *guest, bool suspended)
+{
+    if (!guest || !(Config::self().flags() & Config::Flag_SuspendHiddenDockWidgets))
+        return;
+
+    // The application might have set these on its own guest, so remember what it set and restore
+    // that when resuming, instead of forcing them on.
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    if (suspended) {
+        // updatesEnabled() also reflects the parent, the attribute is only what was set on the guest
+        m_guestUpdatesEnabled = !guest->testAttribute(Qt::WA_ForceUpdatesDisabled);
+        guest->setUpdatesEnabled(false);
+    } else {
+        guest->setUpdatesEnabled(m_guestUpdatesEnabled);
+    }
+#else
+    // Invisible items aren't part of the scene graph
+    if (suspended) {
+        // isVisible() is the effective visibility, it only reflects the app's value while the
+        // parent is visible
+        QQuickItem *parent = guest->parentItem();
+        if (!parent || parent->isVisible())
+            m_guestVisible = guest->isVisible();
+        guest->setVisible(false);
+    } else {
+        guest->setVisible(m_guestVisible);
+    }
+#endif
 }
 
 void DockWidgetBase::Private::close()
@@ -795,6 +930,7 @@ DockWidgetBase *DockWidgetBase::deserialize(const LayoutSaver::DockWidget::Ptr &
             qWarning() << Q_FUNC_INFO << "Affinity name changed from" << dw->affinities()
                        << "; to" << saved->affinities;
             dw->d->affinities = saved->affinities;
+            dw->d->affinityMask = AffinityMask(saved->affinities);
         }
 
     } else {
@@ -862,41 +998,7 @@ DockWidgetBase::Private::Private(const QString &dockName, DockWidgetBase::Option
     , q(qq)
     , options(options_)
     , layoutSaverOptions(layoutSaverOptions_)
-    , toggleAction(new QAction(q))
-    , floatAction(new QAction(q))
 {
-    q->connect(toggleAction, &QAction::toggled, q, [this](bool enabled) {
-        if (!m_updatingToggleAction) { // guard against recursiveness
-            toggleAction->blockSignals(true); // and don't emit spurious toggle. Like when a dock
-                                              // widget is inserted into a tab widget it might get
-                                              // hide events, ignore those. The Dock Widget is open.
-            m_processingToggleAction = true;
-            toggle(enabled);
-            toggleAction->blockSignals(false);
-            m_processingToggleAction = false;
-        }
-    });
-
-    q->connect(floatAction, &QAction::toggled, q, [this](bool checked) {
-        if (!m_updatingFloatAction) { // guard against recursiveness
-            q->setFloating(checked);
-        }
-
-        Q_EMIT q->isFloatingChanged(checked);
-
-        // When floating, we remove from the sidebar
-        if (checked && q->isOpen()) {
-            if (SideBar *sb = DockRegistry::self()->sideBarForDockWidget(q)) {
-                sb->mainWindow()->clearSideBarOverlay(/* deleteFrame=*/false);
-                sb->removeDockWidget(q);
-            }
-        }
-    });
-
-    toggleAction->setCheckable(true);
-    floatAction->setCheckable(true);
-
-    qApp->installEventFilter(this);
 }
 
 void DockWidgetBase::Private::addPlaceholderItem(Layouting::Item *item)
@@ -62,6 +62,7 @@ class DOCKS_EXPORT DockWidgetBase : public QWidget
     Q_OBJECT
     Q_PROPERTY(bool isFocused READ isFocused NOTIFY isFocusedChanged)
     Q_PROPERTY(bool isFloating READ isFloating WRITE setFloating NOTIFY isFloatingChanged)
+    Q_PROPERTY(bool isSuspended READ isSuspended NOTIFY isSuspendedChanged)
     Q_PROPERTY(QString uniqueName READ uniqueName CONSTANT)
     Q_PROPERTY(QString title READ title WRITE setTitle NOTIFY titleChanged)
     Q_PROPERTY(QObject *widget READ widget NOTIFY widgetChanged)
@@ -414,6 +415,15 @@ public:
     /// Empty otherwise
     QSize lastOverlayedSize() const;
 
+    /// @brief Returns whether this dock widget can't currently be seen by the user.
+    ///
+    /// That's the case when it's in a tab that isn't current, when it's closed, or when it's
+    /// minimized to a side-bar and not overlayed. Connect to isSuspendedChanged() to pause timers
+    /// and model updates that only matter for what's on screen.
+    /// With Config::Flag_SuspendHiddenDockWidgets the guest widget is also told to stop painting
+    /// (QWidget::setUpdatesEnabled(false) for QtWidgets, hidden for QtQuick).
+    bool isSuspended() const;
+
 
     /// @brief Returns a dock widget by its name
     /// This is the same name you passed to DockWidget CTOR.
@@ -485,6 +495,10 @@ Q_SIGNALS:
     ///@brief emitted when isFloating changes
     void isFloatingChanged(bool);
 
+    ///@brief emitted when isSuspended changes
+    ///@sa isSuspended
+    void isSuspendedChanged(bool suspended);
+
     ///@brief emitted when this dock widget is removed from a side-bar.
     ///Only relevant for the auto-hide/sidebar feature
     void removedFromSideBar();
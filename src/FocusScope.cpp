@@ -36,11 +36,6 @@ public:
         : q(qq)
         , m_thisWidget(thisWidget)
     {
-        connect(qApp, &QGuiApplication::focusObjectChanged,
-                this, &Private::onFocusObjectChanged);
-
-        onFocusObjectChanged(qApp->focusObject());
-        m_inCtor = false;
     }
 
     /// @brief Returns whether the last focused widget is the tab widget itself
@@ -62,7 +57,6 @@ public:
     ~Private() override;
 
     void setIsFocused(bool);
-    void onFocusObjectChanged(QObject *);
     bool isInFocusScope(WidgetType *) const;
 
     FocusScope *const q;
@@ -79,10 +73,23 @@ FocusScope::Private::~Private()
 FocusScope::FocusScope(QWidgetAdapter *thisWidget)
     : d(new Private(this, thisWidget))
 {
+    // DockRegistry tells us about focus changes, as it can resolve the scope with a single walk
+    // up the parents of the focus object, instead of each scope doing its own walk.
+    DockRegistry *registry = DockRegistry::self();
+    registry->registerFocusScope(this, thisWidget);
+
+    auto focusObject = qobject_cast<WidgetType *>(qApp->focusObject());
+    if (focusObject && d->isInFocusScope(focusObject)) {
+        registry->registerFocusedScope(thisWidget);
+        onFocusObjectChanged(focusObject, true);
+    }
+
+    d->m_inCtor = false;
 }
 
 FocusScope::~FocusScope()
 {
+    DockRegistry::self()->unregisterFocusScope(d->m_thisWidget);
     delete d;
 }
 
@@ -128,22 +135,25 @@ void FocusScope::Private::setIsFocused(bool is)
     }
 }
 
-void FocusScope::Private::onFocusObjectChanged(QObject *obj)
+void FocusScope::onFocusObjectChanged(WidgetType *focusObject, bool isInScope)
 {
-    auto widget = qobject_cast<WidgetType*>(obj);
-    if (!widget) {
-        setIsFocused(false);
-        return;
+    if (isInScope && d->m_lastFocusedInScope != focusObject && !qobject_cast<TitleBar*>(focusObject)) {
+        d->m_lastFocusedInScope = focusObject;
+        d->setIsFocused(true);
+        /* Q_EMIT */ focusedWidgetChangedCallback();
+    } else {
+        d->setIsFocused(isInScope);
     }
+}
 
-    const bool is = isInFocusScope(widget);
-    if (is && m_lastFocusedInScope != widget && !qobject_cast<TitleBar*>(obj)) {
-        m_lastFocusedInScope = widget;
-        setIsFocused(is);
-        /* Q_EMIT */ q->focusedWidgetChangedCallback();
-    } else {
-        setIsFocused(is);
+void FocusScope::resetFocusedWidget()
+{
+    if (d->m_lastFocusedInScope) {
+        d->m_lastFocusedInScope = nullptr;
+        /* Q_EMIT */ focusedWidgetChangedCallback();
     }
+
+    d->setIsFocused(false);
 }
 
 bool FocusScope::Private::isInFocusScope(WidgetType *widget) const
@@ -54,7 +54,16 @@ protected:
     virtual void isFocusedChangedCallback() = 0;
     virtual void focusedWidgetChangedCallback() = 0;
 
+    ///@brief Forgets the last focused widget and loses focus. Used when a Frame is recycled.
+    void resetFocusedWidget();
+
 private:
+    friend class DockRegistry;
+
+    ///@brief Called by DockRegistry when the focus object changes and this scope either contained
+    /// the previous one or contains the new one
+    void onFocusObjectChanged(WidgetType *focusObject, bool isInScope);
+
     class Private;
     Private *const d;
 };
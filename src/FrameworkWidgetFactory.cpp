@@ -19,6 +19,17 @@
 #include "indicators/NullIndicators_p.h"
 #include "Utils_p.h"
 #include "TabWidget_p.h"
+#include "DockRegistry_p.h"
+#include "DragController_p.h"
+#include "MainWindowBase.h"
+#include "Tracer_p.h"
+
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QHash>
+#include <QPointer>
+#include <QScreen>
+#include <QTimer>
 
 #ifdef KDDOCKWIDGETS_QTWIDGETS
 # include "widgets/FrameWidget_p.h"
@@ -49,8 +60,200 @@ using namespace KDDockWidgets;
 
 DropIndicatorType DefaultWidgetFactory::s_dropIndicatorType = DropIndicatorType::Classic;
 
+/// @brief Interval for refilling the FloatingWindow pool, so we don't compete with the drag that emptied it
+static const int s_floatingWindowPoolRefillMs = 250;
+
+namespace {
+
+/// @brief The frame and FloatingWindow pools of a factory.
+/// Kept out of FrameworkWidgetFactory so its size doesn't change for the sub-classes users wrote.
+class FactoryPools
+{
+public:
+    explicit FactoryPools(FrameworkWidgetFactory *factory)
+        : q(factory)
+    {
+        floatingWindowPoolTimer.setSingleShot(true);
+        floatingWindowPoolTimer.setInterval(s_floatingWindowPoolRefillMs);
+        QObject::connect(&floatingWindowPoolTimer, &QTimer::timeout, factory, [this] {
+            refillFloatingWindowPool();
+        });
+
+        // Pooled frames and windows are widgets, they can't outlive the application
+        if (qApp)
+            QObject::connect(qApp, &QCoreApplication::aboutToQuit, factory, [this] { clear(); });
+    }
+
+    ~FactoryPools()
+    {
+        if (qApp)
+            clear();
+    }
+
+    void clear()
+    {
+        floatingWindowPoolTimer.stop();
+
+        const auto frames = framePool;
+        framePool.clear();
+        qDeleteAll(frames);
+
+        const auto windows = floatingWindowPool;
+        floatingWindowPool.clear();
+        qDeleteAll(windows);
+    }
+
+    void refillFloatingWindowPool();
+
+    FrameworkWidgetFactory *const q;
+    QVector<QPointer<Frame>> framePool;
+    int framePoolSize = 0;
+    QVector<QPointer<FloatingWindow>> floatingWindowPool; // parentless, see FloatingWindow::adoptFrame()
+    int floatingWindowPoolSize = 0;
+    QTimer floatingWindowPoolTimer;
+};
+
+void FactoryPools::refillFloatingWindowPool()
+{
+    if (QCoreApplication::closingDown())
+        return;
+
+    if (DragController::instance()->isDragging()) {
+        // Try again once the user is done
+        floatingWindowPoolTimer.start();
+        return;
+    }
+
+    floatingWindowPool.removeAll(nullptr);
+    if (floatingWindowPool.size() >= floatingWindowPoolSize)
+        return;
+
+    // One at a time, so we don't block the event loop for long.
+    // No parent yet, it depends on the frame that will be floated
+    FloatingWindow *window = q->createFloatingWindow(nullptr);
+    window->prepareForPool();
+    floatingWindowPool.push_back(window);
+
+    if (floatingWindowPool.size() < floatingWindowPoolSize)
+        floatingWindowPoolTimer.start();
+}
+
+}
+
+/// @brief The pools of each factory, only for the ones which enabled pooling
+static QHash<const FrameworkWidgetFactory *, FactoryPools *> &factoryPools()
+{
+    static QHash<const FrameworkWidgetFactory *, FactoryPools *> pools;
+    return pools;
+}
+
+/// @brief Returns the pools of @p factory, or nullptr if it never enabled pooling
+static FactoryPools *existingPoolsFor(const FrameworkWidgetFactory *factory)
+{
+    return factoryPools().value(factory);
+}
+
+static FactoryPools *poolsFor(FrameworkWidgetFactory *factory)
+{
+    FactoryPools *&pools = factoryPools()[factory];
+    if (!pools)
+        pools = new FactoryPools(factory);
+    return pools;
+}
+
 FrameworkWidgetFactory::~FrameworkWidgetFactory()
 {
+    delete factoryPools().take(this);
+}
+
+void FrameworkWidgetFactory::setFramePoolSize(int size)
+{
+    FactoryPools *pools = poolsFor(this);
+    pools->framePoolSize = qMax(0, size);
+    while (pools->framePool.size() > pools->framePoolSize)
+        delete pools->framePool.takeLast();
+}
+
+int FrameworkWidgetFactory::framePoolSize() const
+{
+    FactoryPools *pools = existingPoolsFor(this);
+    return pools ? pools->framePoolSize : 0;
+}
+
+int FrameworkWidgetFactory::dbg_numPooledFrames() const
+{
+    FactoryPools *pools = existingPoolsFor(this);
+    return pools ? pools->framePool.size() : 0;
+}
+
+void FrameworkWidgetFactory::setFloatingWindowPoolSize(int size)
+{
+    FactoryPools *pools = poolsFor(this);
+    pools->floatingWindowPoolSize = qMax(0, size);
+    while (pools->floatingWindowPool.size() > pools->floatingWindowPoolSize)
+        delete pools->floatingWindowPool.takeLast();
+
+    if (pools->floatingWindowPool.size() < pools->floatingWindowPoolSize)
+        pools->floatingWindowPoolTimer.start();
+}
+
+int FrameworkWidgetFactory::floatingWindowPoolSize() const
+{
+    FactoryPools *pools = existingPoolsFor(this);
+    return pools ? pools->floatingWindowPoolSize : 0;
+}
+
+int FrameworkWidgetFactory::dbg_numPooledFloatingWindows() const
+{
+    FactoryPools *pools = existingPoolsFor(this);
+    return pools ? pools->floatingWindowPool.size() : 0;
+}
+
+FloatingWindow *FrameworkWidgetFactory::acquireFloatingWindow(Frame *frame, MainWindowBase *parent)
+{
+    FloatingWindow *window = nullptr;
+    FactoryPools *pools = existingPoolsFor(this);
+    if (pools && pools->floatingWindowPoolSize > 0) {
+        while (!window && !pools->floatingWindowPool.isEmpty())
+            window = pools->floatingWindowPool.takeLast();
+
+        // Refill later, when the user is done dragging
+        pools->floatingWindowPoolTimer.start();
+    }
+
+    if (!window)
+        return createFloatingWindow(frame, parent);
+
+    window->adoptFrame(frame, parent);
+    return window;
+}
+
+Frame *FrameworkWidgetFactory::acquireFrame(QWidgetOrQuick *parent, FrameOptions options)
+{
+    Debug::TraceSpan span("acquireFrame");
+    if (FactoryPools *pools = existingPoolsFor(this)) {
+        while (!pools->framePool.isEmpty()) {
+            if (Frame *frame = pools->framePool.takeLast()) {
+                frame->reuse(parent, options);
+                return frame;
+            }
+        }
+    }
+
+    return createFrame(parent, options);
+}
+
+bool FrameworkWidgetFactory::releaseFrame(Frame *frame)
+{
+    FactoryPools *pools = existingPoolsFor(this);
+    if (!frame || !pools || pools->framePool.size() >= pools->framePoolSize)
+        return false;
+
+    if (!frame->prepareForReuse())
+        return false;
+
+    pools->framePool.push_back(frame);
+    return true;
 }
 
 #ifdef KDDOCKWIDGETS_QTWIDGETS
@@ -234,8 +437,28 @@ QUrl DefaultWidgetFactory::floatingWindowFilename() const
 
 #endif // QtQuick
 
-// iconForButtonType impl is the same for QtQuick and QtWidgets
-QIcon DefaultWidgetFactory::iconForButtonType(TitleBarButtonType type, qreal dpr) const
+using TitleBarIconKey = QPair<int, bool>; // type, and whether the DPR is supported
+using TitleBarIconCache = QHash<TitleBarIconKey, QIcon>;
+
+/// @brief Process-wide cache for DefaultWidgetFactory::iconForButtonType()
+/// Copies of a QIcon share the same engine, so every button also shares the decoded pixmaps.
+/// Not keyed by the DPR itself: the icon contains every resolution and QIcon picks the right
+/// one when painting, so DPR changes, like a window moving to another screen, don't need new icons.
+static TitleBarIconCache &titleBarIconCache()
+{
+    static TitleBarIconCache s_cache;
+    static QPointer<QGuiApplication> s_app;
+
+    if (qGuiApp && s_app != qGuiApp) {
+        s_app = qGuiApp;
+        // QIcon holds pixmaps, which can't outlive the application
+        qAddPostRoutine([] { s_cache.clear(); });
+    }
+
+    return s_cache;
+}
+
+static QIcon createIconForButtonType(TitleBarButtonType type, qreal dpr)
 {
     QString iconName;
     switch (type) {
@@ -280,3 +503,17 @@ QIcon DefaultWidgetFactory::iconForButtonType(TitleBarButtonType type, qreal dpr
 
     return icon;
 }
+
+// iconForButtonType impl is the same for QtQuick and QtWidgets
+QIcon DefaultWidgetFactory::iconForButtonType(TitleBarButtonType type, qreal dpr) const
+{
+    TitleBarIconCache &cache = titleBarIconCache();
+    const TitleBarIconKey key = { int(type), scalingFactorIsSupported(dpr) };
+    auto it = cache.constFind(key);
+    if (it != cache.cend())
+        return it.value();
+
+    const QIcon icon = createIconForButtonType(type, dpr);
+    cache.insert(key, icon);
+    return icon;
+}
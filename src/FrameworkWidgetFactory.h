@@ -74,6 +74,58 @@ public:
     /// by the framework.
     virtual ~FrameworkWidgetFactory();
 
+    ///@brief Sets how many unused frames are kept around to be reused later. Default is 0, meaning
+    ///       frames are deleted as soon as they become empty.
+    ///
+    /// Docking, undocking, detaching tabs and showing an auto-hide overlay all create and destroy
+    /// frames. With a pool, an empty frame is reset and handed out again by acquireFrame() instead,
+    /// together with its TitleBar, TabWidget and TabBar, which saves their construction.
+    /// Only frames created by createFrame() are recycled, so your Frame sub-classes are honoured,
+    /// but they need to be able to go from one layout to another.
+    ///@param size the maximum number of frames to keep in the pool
+    void setFramePoolSize(int size);
+
+    ///@brief Returns the maximum number of unused frames kept for reuse
+    ///@sa setFramePoolSize()
+    int framePoolSize() const;
+
+    ///@brief Returns the number of unused frames currently in the pool. For tests.
+    int dbg_numPooledFrames() const;
+
+    ///@brief Sets how many hidden FloatingWindows are kept ready for when a dock widget or tab is
+    ///       detached. Default is 0, meaning they are created on demand.
+    ///
+    /// Creating a FloatingWindow and its native window is noticeable when the user starts dragging
+    /// a tab. With a pool, windows are created ahead of time, when the application is idle, so
+    /// detaching just takes one. The pool is refilled in the background afterwards.
+    /// One or two windows are usually enough.
+    ///@param size the number of windows to keep ready
+    void setFloatingWindowPoolSize(int size);
+
+    ///@brief Returns the number of hidden FloatingWindows kept ready
+    ///@sa setFloatingWindowPoolSize()
+    int floatingWindowPoolSize() const;
+
+    ///@brief Returns the number of FloatingWindows currently waiting in the pool. For tests.
+    int dbg_numPooledFloatingWindows() const;
+
+    ///@brief Called internally by the framework whenever it needs a FloatingWindow for @p frame.
+    ///       Returns a window from the pool if there's one, otherwise calls createFloatingWindow()
+    ///@param frame Just forward to FloatingWindow's constructor.
+    ///@param parent Just forward to FloatingWindow's constructor.
+    FloatingWindow *acquireFloatingWindow(Frame *frame, MainWindowBase *parent = nullptr);
+
+    ///@brief Called internally by the framework whenever it needs a Frame.
+    ///       Returns a frame from the pool if there's one, otherwise calls createFrame()
+    ///@param parent just forward to Frame's constructor
+    ///@param options just forward to Frame's constructor
+    Frame *acquireFrame(QWidgetOrQuick *parent = nullptr, FrameOptions options = FrameOption_None);
+
+    ///@brief Called internally by the framework when an empty frame isn't needed anymore.
+    ///       Returns true if the frame was reset and put into the pool, false if the caller
+    ///       should delete it.
+    bool releaseFrame(Frame *);
+
     ///@brief Called internally by the framework to create a Frame class
     ///       Override to provide your own Frame sub-class. A frame is the
     ///       widget that holds the titlebar and tab-widget which holds the
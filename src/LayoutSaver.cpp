@@ -29,9 +29,11 @@
 #include "Logging_p.h"
 #include "MainWindowBase.h"
 #include "Position_p.h"
+#include "Tracer_p.h"
 
 #include <qmath.h>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QFile>
 
 /**
@@ -74,6 +76,7 @@ inline InternalRestoreOptions internalRestoreOptions(RestoreOptions options)
 }
 
 bool LayoutSaver::Private::s_restoreInProgress = false;
+LayoutSaver::Private::RestoreTimings LayoutSaver::Private::s_lastRestoreTimings;
 
 static QVariantList stringListToVariant(const QStringList &strs)
 {
@@ -145,6 +148,12 @@ QByteArray LayoutSaver::serializeLayout() const
     // Just a simplification. One less type of windows to handle.
     d->m_dockRegistry->ensureAllFloatingWidgetsAreMorphed();
 
+    if (Config::self().flags() & Config::Flag_CompactPlaceholdersOnSave) {
+        const auto layouts = d->m_dockRegistry->layouts();
+        for (LayoutWidget *layout : layouts)
+            layout->compactPlaceholders();
+    }
+
     const MainWindowBase::List mainWindows = d->m_dockRegistry->mainwindows();
     layout.mainWindows.reserve(mainWindows.size());
     for (MainWindowBase *mainWindow : mainWindows) {
@@ -203,7 +212,21 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
         LayoutSaver *const m_saver;
     };
 
+    Debug::TraceSpan span("restoreLayout");
     FrameCleanup cleanup(this);
+
+    Private::RestoreTimings &timings = Private::s_lastRestoreTimings;
+    timings = {};
+    QElapsedTimer phaseTimer;
+    phaseTimer.start();
+    auto lap = [&phaseTimer] (const char *phaseName) {
+        const qint64 elapsed = phaseTimer.nsecsElapsed();
+        phaseTimer.start();
+        if (Debug::Tracer::isEnabled())
+            Debug::Tracer::addSpan(phaseName, Debug::Tracer::now() - elapsed, elapsed);
+        return elapsed;
+    };
+
     LayoutSaver::Layout layout;
     if (!layout.fromJson(data)) {
         qWarning() << Q_FUNC_INFO << "Failed to parse json data";
@@ -215,6 +238,7 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
     }
 
     layout.scaleSizes(d->m_restoreOptions);
+    timings.parse = lap("restoreLayout.parse");
 
     d->floatWidgetsWhichSkipRestore(layout.mainWindowNames());
 
@@ -226,6 +250,7 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
     d->m_dockRegistry->clear(d->m_dockRegistry->dockWidgets(layout.dockWidgetsToClose()),
                              d->m_dockRegistry->mainWindows(layout.mainWindowNames()),
                              d->m_affinityNames);
+    timings.clear = lap("restoreLayout.clear");
 
     // 1. Restore main windows
     for (const LayoutSaver::MainWindow &mw : qAsConst(layout.mainWindows)) {
@@ -254,6 +279,7 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
         if (!mainWindow->deserialize(mw))
             return false;
     }
+    timings.mainWindows = lap("restoreLayout.mainWindows");
 
     // 2. Restore FloatingWindows
     for (LayoutSaver::FloatingWindow &fw : layout.floatingWindows) {
@@ -271,6 +297,7 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
             return false;
         }
     }
+    timings.floatingWindows = lap("restoreLayout.floatingWindows");
 
     // 3. Restore closed dock widgets. They remain closed but acquire geometry and placeholder properties
     for (const auto &dw : qAsConst(layout.closedDockWidgets)) {
@@ -278,6 +305,7 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
             DockWidgetBase::deserialize(dw);
         }
     }
+    timings.closedDockWidgets = lap("restoreLayout.closedDockWidgets");
 
     // 4. Restore the placeholder info, now that the Items have been created
     for (const auto &dw : qAsConst(layout.allDockWidgets)) {
@@ -291,6 +319,7 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
             qWarning() << Q_FUNC_INFO << "Couldn't find dock widget" << dw->uniqueName;
         }
     }
+    timings.placeholders = lap("restoreLayout.placeholders");
 
     return true;
 }
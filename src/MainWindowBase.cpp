@@ -18,6 +18,7 @@
  */
 
 #include "MainWindowBase.h"
+#include "AffinityMask_p.h"
 #include "DockRegistry_p.h"
 #include "MDILayoutWidget_p.h"
 #include "DropArea_p.h"
@@ -65,6 +66,7 @@ public:
 
     QString name;
     QStringList affinities;
+    AffinityMask affinityMask; // same as affinities, interned
     const MainWindowOptions m_options;
     MainWindowBase *const q;
     QPointer<DockWidgetBase> m_overlayedDockWidget;
@@ -93,7 +95,7 @@ void MainWindowBase::addDockWidgetAsTab(DockWidgetBase *widget)
     Q_ASSERT(widget);
     qCDebug(addwidget) << Q_FUNC_INFO << widget;
 
-    if (!DockRegistry::self()->affinitiesMatch(d->affinities, widget->affinities())) {
+    if (!d->affinityMask.matches(widget->d->affinityMask)) {
         qWarning() << Q_FUNC_INFO << "Refusing to dock widget with incompatible affinity."
                    << widget->affinities() << affinities();
         return;
@@ -178,6 +180,9 @@ void MainWindowBase::setAffinities(const QStringList &affinityNames)
     }
 
     d->affinities = affinities;
+    d->affinityMask = AffinityMask(affinities);
+    if (DropArea *dropArea = this->dropArea())
+        dropArea->setMainWindowAffinityMask(d->affinityMask);
 }
 
 QStringList MainWindowBase::affinities() const
@@ -496,7 +501,7 @@ void MainWindowBase::overlayOnSideBar(DockWidgetBase *dw)
     // We only support one overlay at a time, remove any existing overlay
     clearSideBarOverlay();
 
-    auto frame = Config::self().frameworkWidgetFactory()->createFrame(this, FrameOption_IsOverlayed);
+    auto frame = Config::self().frameworkWidgetFactory()->acquireFrame(this, FrameOption_IsOverlayed);
     d->m_overlayedDockWidget = dw;
     frame->addWidget(dw);
     d->updateOverlayGeometry(dw->d->lastPositions().lastOverlayedGeometry(sb->location()).size());
@@ -537,7 +542,8 @@ void MainWindowBase::clearSideBarOverlay(bool deleteFrame)
         d->m_overlayedDockWidget->setParent(nullptr);
         Q_EMIT d->m_overlayedDockWidget->isOverlayedChanged(false);
         d->m_overlayedDockWidget = nullptr;
-        delete frame;
+        if (!Config::self().frameworkWidgetFactory()->releaseFrame(frame))
+            delete frame;
     } else {
         // No cleanup, just unset. When we drag the overlay it becomes a normal floating window
         // meaning we reuse Frame. Don't delete it.
@@ -653,6 +659,9 @@ bool MainWindowBase::deserialize(const LayoutSaver::MainWindow &mw)
                    << "; to" << mw.affinities;
 
         d->affinities = mw.affinities;
+        d->affinityMask = AffinityMask(mw.affinities);
+        if (DropArea *dropArea = this->dropArea())
+            dropArea->setMainWindowAffinityMask(d->affinityMask);
     }
 
     const bool success = layoutWidget()->deserialize(mw.multiSplitterLayout);
@@ -31,6 +31,11 @@ inline QPoint eventPos(QDropEvent *ev)
     return ev->position().toPoint();
 }
 
+inline QPoint eventPos(QMouseEvent *ev)
+{
+    return ev->position().toPoint();
+}
+
 inline QPoint eventGlobalPos(QMouseEvent *ev)
 {
     return ev->globalPosition().toPoint();
@@ -49,6 +54,11 @@ inline QPoint eventPos(QDropEvent *ev)
     return ev->pos();
 }
 
+inline QPoint eventPos(QMouseEvent *ev)
+{
+    return ev->pos();
+}
+
 inline QPoint eventGlobalPos(QMouseEvent *ev)
 {
     return ev->globalPos();
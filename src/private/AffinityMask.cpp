@@ -0,0 +1,73 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2021 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "AffinityMask_p.h"
+
+#include <QHash>
+
+using namespace KDDockWidgets;
+
+/// @brief Returns the bit for affinity @p name, assigning the next free one if it's new
+static int bitForAffinity(const QString &name)
+{
+    static QHash<QString, int> s_bits;
+    auto it = s_bits.constFind(name);
+    if (it != s_bits.cend())
+        return it.value();
+
+    const int bit = s_bits.size();
+    s_bits.insert(name, bit);
+    return bit;
+}
+
+AffinityMask::AffinityMask(const QStringList &names)
+{
+    for (const QString &name : names) {
+        if (!name.isEmpty())
+            setBit(bitForAffinity(name));
+    }
+}
+
+bool AffinityMask::matches(const AffinityMask &other) const
+{
+    if (isEmpty() && other.isEmpty())
+        return true;
+
+    const int count = qMin(m_words.size(), other.m_words.size());
+    for (int i = 0; i < count; ++i) {
+        if (m_words.at(i) & other.m_words.at(i))
+            return true;
+    }
+
+    return false;
+}
+
+bool AffinityMask::operator==(const AffinityMask &other) const
+{
+    if (m_words.size() != other.m_words.size())
+        return false;
+
+    for (int i = 0, count = m_words.size(); i < count; ++i) {
+        if (m_words.at(i) != other.m_words.at(i))
+            return false;
+    }
+
+    return true;
+}
+
+void AffinityMask::setBit(int bit)
+{
+    const int word = bit / 64;
+    while (m_words.size() <= word)
+        m_words.append(0);
+
+    m_words[word] |= quint64(1) << (bit % 64);
+}
@@ -0,0 +1,65 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2021 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+/**
+ * @file Affinity names stored as bits, so matching them doesn't compare strings.
+ *
+ * @author Sérgio Martins \<sergio.martins@kdab.com\>
+ */
+
+#ifndef KDDOCKWIDGETS_AFFINITYMASK_P_H
+#define KDDOCKWIDGETS_AFFINITYMASK_P_H
+
+#include "kddockwidgets/docks_export.h"
+
+#include <QStringList>
+#include <QVarLengthArray>
+
+namespace KDDockWidgets {
+
+/**
+ * @brief A set of affinity names, as a bitset
+ *
+ * Each name gets its own bit the first time it's seen, in a global table that only grows.
+ * Matching two sets is then an AND. The first 64 distinct names don't allocate.
+ */
+class DOCKS_EXPORT_FOR_UNIT_TESTS AffinityMask
+{
+public:
+    AffinityMask() = default;
+    explicit AffinityMask(const QStringList &names);
+
+    ///@brief Returns true if there are no affinities
+    bool isEmpty() const
+    {
+        return m_words.isEmpty();
+    }
+
+    ///@brief Returns true if both are empty or if they have at least one affinity in common
+    /// Same semantics as DockRegistry::affinitiesMatch()
+    bool matches(const AffinityMask &other) const;
+
+    bool operator==(const AffinityMask &other) const;
+    bool operator!=(const AffinityMask &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    void setBit(int bit);
+
+    // Trailing zero words are never stored, so isEmpty() and operator== are trivial
+    QVarLengthArray<quint64, 1> m_words;
+};
+
+}
+
+#endif
@@ -23,6 +23,7 @@
 #include "LayoutWidget_p.h"
 #include "MainWindow.h"
 #include "ObjectViewer_p.h"
+#include "PerformanceView_p.h"
 #include "Qt5Qt6Compat_p.h"
 
 #include <QVBoxLayout>
@@ -30,6 +31,7 @@
 #include <QPushButton>
 #include <QLineEdit>
 #include <QSpinBox>
+#include <QTabWidget>
 #include <QMessageBox>
 #include <QApplication>
 #include <QMouseEvent>
@@ -82,7 +84,15 @@ DebugWindow::DebugWindow(QWidget *parent)
     , m_objectViewer(this)
 {
     // qApp->installNativeEventFilter(new DebugAppEventFilter());
-    auto layout = new QVBoxLayout(this);
+    auto tabWidget = new QTabWidget(this);
+    auto topLayout = new QVBoxLayout(this);
+    topLayout->addWidget(tabWidget);
+
+    auto objectsPage = new QWidget(tabWidget);
+    tabWidget->addTab(objectsPage, QStringLiteral("Objects"));
+    tabWidget->addTab(new PerformanceView(tabWidget), QStringLiteral("Performance"));
+
+    auto layout = new QVBoxLayout(objectsPage);
     layout->addWidget(&m_objectViewer);
 
     auto button = new QPushButton(this);
@@ -14,17 +14,23 @@
 #include "DockWidgetBase.h"
 #include "DockWidgetBase_p.h"
 #include "FloatingWindow_p.h"
+#include "LayoutSaver_p.h"
 #include "LayoutWidget_p.h"
 #include "Logging_p.h"
 #include "MainWindowMDI.h"
 #include "Position_p.h"
 #include "QWidgetAdapter.h"
+#include "SessionRecorder_p.h"
 #include "SideBar_p.h"
+#include "Tracer_p.h"
 #include "Utils_p.h"
 #include "WidgetResizeHandler_p.h"
 #include "WindowBeingDragged_p.h"
+#include "multisplitter/Item_p.h"
+#include "multisplitter/Separator_p.h"
 
 #include <QPointer>
+#include <QSet>
 #include <QDebug>
 #include <QGuiApplication>
 #include <QWindow>
@@ -66,6 +72,19 @@ DockRegistry::DockRegistry(QObject *parent)
     QQuickWindow::setDefaultAlphaBuffer(true);
 #endif
 
+#ifdef DOCKS_DEVELOPER_MODE
+    const QString sessionFile = qEnvironmentVariable("KDDOCKWIDGETS_RECORD_SESSION");
+    if (!sessionFile.isEmpty())
+        new Debug::SessionRecorder(sessionFile, this);
+#endif
+
+    const QString traceFile = qEnvironmentVariable("KDDOCKWIDGETS_TRACE_FILE");
+    if (!traceFile.isEmpty() && !Debug::Tracer::isEnabled()) {
+        Debug::Tracer::start(traceFile);
+        // Not with us as context, we're deleted whenever the last dock widget or window goes away
+        connect(qApp, &QCoreApplication::aboutToQuit, qApp, [] { Debug::Tracer::stop(); });
+    }
+
     connect(qApp, &QGuiApplication::focusObjectChanged,
             this, &DockRegistry::onFocusObjectChanged);
 
@@ -84,27 +103,72 @@ void DockRegistry::maybeDelete()
 
 void DockRegistry::onFocusObjectChanged(QObject *obj)
 {
-    auto p = qobject_cast<WidgetType*>(obj);
-    while (p) {
+    // A single walk up the parents finds both the focused dock widget and the focus scopes
+    // containing the focus object
+    auto widget = qobject_cast<WidgetType*>(obj);
+    bool foundDockWidget = false;
+    DockWidgetBase *focusedDockWidget = nullptr;
+    QVector<const QObject *> focusedScopes;
+
+    for (WidgetType *p = widget; p; p = KDDockWidgets::Private::parentWidget(p)) {
+        if (m_focusScopes.contains(p))
+            focusedScopes.push_back(p);
+
+        if (foundDockWidget)
+            continue;
+
         if (auto frame = qobject_cast<Frame *>(p)) {
             // Special case: The focused widget is inside the frame but not inside the dockwidget.
             // For example, it's a line edit in the QTabBar. We still need to send the signal for
             // the current dw in the tab group
-            if (auto dw = frame->currentDockWidget()) {
-                setFocusedDockWidget(dw);
-            }
-
-            return;
+            focusedDockWidget = frame->currentDockWidget();
+            foundDockWidget = true;
+        } else if (auto dw = qobject_cast<DockWidgetBase *>(p)) {
+            focusedDockWidget = dw;
+            foundDockWidget = true;
         }
+    }
 
-        if (auto dw = qobject_cast<DockWidgetBase *>(p)) {
-            DockRegistry::self()->setFocusedDockWidget(dw);
-            return;
-        }
-        p = KDDockWidgets::Private::parentWidget(p);
+    if (!foundDockWidget) {
+        setFocusedDockWidget(nullptr);
+    } else if (focusedDockWidget) {
+        setFocusedDockWidget(focusedDockWidget);
     }
 
-    setFocusedDockWidget(nullptr);
+    // Only the scopes which lost focus and the ones which got it need to know.
+    // Scopes are looked up again, as the callbacks might delete them.
+    const QVector<const QObject *> previouslyFocusedScopes = m_focusedScopes;
+    m_focusedScopes = focusedScopes;
+
+    for (const QObject *scopeWidget : previouslyFocusedScopes) {
+        if (focusedScopes.contains(scopeWidget))
+            continue;
+
+        if (FocusScope *scope = m_focusScopes.value(scopeWidget))
+            scope->onFocusObjectChanged(widget, false);
+    }
+
+    for (const QObject *scopeWidget : qAsConst(focusedScopes)) {
+        if (FocusScope *scope = m_focusScopes.value(scopeWidget))
+            scope->onFocusObjectChanged(widget, true);
+    }
+}
+
+void DockRegistry::registerFocusScope(FocusScope *scope, QWidgetAdapter *scopeWidget)
+{
+    m_focusScopes.insert(scopeWidget, scope);
+}
+
+void DockRegistry::registerFocusedScope(QWidgetAdapter *scopeWidget)
+{
+    if (!m_focusedScopes.contains(scopeWidget))
+        m_focusedScopes.push_back(scopeWidget);
+}
+
+void DockRegistry::unregisterFocusScope(QWidgetAdapter *scopeWidget)
+{
+    m_focusScopes.remove(scopeWidget);
+    m_focusedScopes.removeOne(scopeWidget);
 }
 
 void DockRegistry::setFocusedDockWidget(DockWidgetBase *dw)
@@ -146,10 +210,20 @@ bool DockRegistry::isProcessingAppQuitEvent() const
 
 bool DockRegistry::affinitiesMatch(const QStringList &affinities1, const QStringList &affinities2) const
 {
-    if (affinities1.isEmpty() && affinities2.isEmpty())
+    // Compares strings instead of building AffinityMasks, which would intern arbitrary names
+    // into the global table. Empty names don't count, same as with AffinityMask.
+    auto isEmpty = [] (const QStringList &affinities) {
+        return std::all_of(affinities.cbegin(), affinities.cend(), [] (const QString &a) {
+            return a.isEmpty();
+        });
+    };
+
+    if (isEmpty(affinities1) && isEmpty(affinities2))
         return true;
 
     for (const QString &a1 : affinities1) {
+        if (a1.isEmpty())
+            continue;
         for (const QString &a2 : affinities2) {
             if (a1 == a2)
                 return true;
@@ -187,7 +261,7 @@ bool DockRegistry::isProbablyObscured(QWindow *window, FloatingWindow *exclude)
     const QRect geo = window->geometry();
     for (FloatingWindow *fw : m_floatingWindows) {
         QWindow *fwWindow = fw->QWidgetAdapter::windowHandle();
-        if (fw == exclude || fwWindow == window)
+        if (fw == exclude || fwWindow == window || !fwWindow || !fwWindow->isVisible())
             continue;
 
         if (fwWindow->geometry().intersects(geo)) {
@@ -237,6 +311,92 @@ SideBar *DockRegistry::sideBarForDockWidget(const DockWidgetBase *dw) const
     return nullptr;
 }
 
+static DockRegistry::LayoutMemoryUsage layoutMemoryUsage(const QString &name, LayoutWidget *layout,
+                                                         int placeholderRefs)
+{
+    DockRegistry::LayoutMemoryUsage usage;
+    usage.name = name;
+    usage.frames = layout->frames().size();
+    usage.dockWidgets = layout->dockWidgets().size();
+    usage.placeholderRefs = placeholderRefs;
+
+    // Containers are found by walking up from the leaves, stopping at the ones we already visited
+    const QVector<Layouting::Item *> items = layout->items();
+    usage.items = items.size();
+    QSet<Layouting::ItemContainer *> containers;
+    for (Layouting::Item *item : items) {
+        if (item->isPlaceholder())
+            usage.placeholders++;
+
+        for (Layouting::ItemContainer *c = item->parentContainer(); c && !containers.contains(c); c = c->parentContainer()) {
+            containers.insert(c);
+            if (Layouting::ItemBoxContainer *box = c->asBoxContainer())
+                usage.separators += box->separators().size();
+        }
+    }
+    usage.containers = containers.size();
+
+    usage.estimatedBytes = qint64(usage.items) * qint64(sizeof(Layouting::Item))
+        + qint64(usage.containers) * qint64(sizeof(Layouting::ItemBoxContainer))
+        + qint64(usage.separators) * qint64(sizeof(Layouting::Separator))
+        + qint64(usage.frames) * qint64(sizeof(Frame))
+        + qint64(usage.placeholderRefs) * qint64(sizeof(ItemRef));
+
+    return usage;
+}
+
+DockRegistry::MemoryReport DockRegistry::memoryReport() const
+{
+    MemoryReport report;
+    report.dockWidgets = m_dockWidgets.size();
+    report.layoutSaverDockWidgets = LayoutSaver::DockWidget::s_dockWidgets.size();
+
+    // Each dock widget remembers where it was, find out which layouts that memory points into
+    QHash<const LayoutWidget *, int> refsPerLayout;
+    for (DockWidgetBase *dw : m_dockWidgets) {
+        if (!dw->isOpen())
+            report.closedDockWidgets++;
+
+        for (const auto &ref : dw->d->lastPositions().placeholders()) {
+            report.placeholderRefs++;
+            if (!ref->guard) {
+                report.danglingPlaceholderRefs++;
+            } else if (LayoutWidget *layout = layoutForItem(ref->item)) {
+                refsPerLayout[layout]++;
+            }
+        }
+    }
+
+    int attributedRefs = 0;
+    for (MainWindowBase *mw : m_mainWindows) {
+        LayoutWidget *layout = mw->layoutWidget();
+        const int refs = refsPerLayout.value(layout);
+        attributedRefs += refs;
+        report.mainWindows.push_back(layoutMemoryUsage(mw->uniqueName(), layout, refs));
+    }
+
+    for (FloatingWindow *fw : m_floatingWindows) {
+        const QVector<DockWidgetBase *> dockWidgets = fw->dockWidgets();
+        const QString name = QStringLiteral("floating:") + (dockWidgets.isEmpty() ? QString()
+                                                                                  : dockWidgets.first()->uniqueName());
+        LayoutWidget *layout = fw->layoutWidget();
+        const int refs = refsPerLayout.value(layout);
+        attributedRefs += refs;
+        report.floatingWindows.push_back(layoutMemoryUsage(name, layout, refs));
+    }
+
+    for (const LayoutMemoryUsage &usage : qAsConst(report.mainWindows))
+        report.estimatedBytes += usage.estimatedBytes;
+    for (const LayoutMemoryUsage &usage : qAsConst(report.floatingWindows))
+        report.estimatedBytes += usage.estimatedBytes;
+
+    report.estimatedBytes += qint64(report.dockWidgets) * qint64(sizeof(DockWidgetBase) + sizeof(DockWidgetBase::Private) + sizeof(Position))
+        + qint64(report.placeholderRefs - attributedRefs) * qint64(sizeof(ItemRef))
+        + qint64(report.layoutSaverDockWidgets) * qint64(sizeof(LayoutSaver::DockWidget));
+
+    return report;
+}
+
 Frame *DockRegistry::frameInMDIResize() const
 {
     for (auto mw : m_mainWindows) {
@@ -344,10 +504,67 @@ void DockRegistry::registerFloatingWindow(FloatingWindow *window)
 
 void DockRegistry::unregisterFloatingWindow(FloatingWindow *window)
 {
-    m_floatingWindows.removeOne(window);
+    unregisterPooledFloatingWindow(window);
     maybeDelete();
 }
 
+void DockRegistry::unregisterPooledFloatingWindow(FloatingWindow *window)
+{
+    m_floatingWindows.removeOne(window);
+
+    for (auto it = m_floatingWindowsByHandle.begin(); it != m_floatingWindowsByHandle.end(); ++it) {
+        if (it->floatingWindow == window) {
+            unindexFloatingWindowHandle(it.key());
+            break;
+        }
+    }
+}
+
+void DockRegistry::indexFloatingWindowHandle(FloatingWindow *fw, QWindow *windowHandle)
+{
+    auto it = m_floatingWindowsByHandle.find(windowHandle);
+    if (it != m_floatingWindowsByHandle.end()) {
+        it->floatingWindow = fw;
+        return;
+    }
+
+    IndexedFloatingWindow indexed;
+    indexed.floatingWindow = fw;
+    indexed.windowDestroyedConnection = connect(windowHandle, &QObject::destroyed, this, [this, windowHandle] {
+        unindexFloatingWindowHandle(windowHandle);
+    });
+
+    m_floatingWindowsByHandle.insert(windowHandle, indexed);
+}
+
+void DockRegistry::unindexFloatingWindowHandle(QWindow *windowHandle)
+{
+    auto it = m_floatingWindowsByHandle.find(windowHandle);
+    if (it == m_floatingWindowsByHandle.end())
+        return;
+
+    disconnect(it->windowDestroyedConnection);
+    m_floatingWindowsByHandle.erase(it);
+}
+
+void DockRegistry::raiseFloatingWindow(FloatingWindow *fw)
+{
+    // Windows get exposed a lot (resizes, being uncovered), usually the one on top already
+    if (m_floatingWindows.isEmpty() || m_floatingWindows.constLast() == fw)
+        return;
+
+    m_floatingWindows.removeOne(fw);
+    m_floatingWindows.append(fw);
+}
+
+void DockRegistry::registerResizeHandler(WidgetResizeHandler *handler)
+{
+    m_resizeHandlers.push_back(handler);
+    connect(handler, &QObject::destroyed, this, [this, handler] {
+        m_resizeHandlers.removeOne(handler);
+    });
+}
+
 void DockRegistry::registerLayout(LayoutWidget *layout)
 {
     m_layouts << layout;
@@ -589,6 +806,17 @@ QWindow *DockRegistry::windowForHandle(WId id) const
 
 FloatingWindow *DockRegistry::floatingWindowForHandle(QWindow *windowHandle) const
 {
+    if (!windowHandle)
+        return nullptr;
+
+    auto it = m_floatingWindowsByHandle.constFind(windowHandle);
+    if (it != m_floatingWindowsByHandle.cend())
+        return it->floatingWindow;
+
+    if (m_floatingWindowsByHandle.size() == m_floatingWindows.size())
+        return nullptr; // They're all indexed, no need to look further
+
+    // Some weren't exposed yet
     for (FloatingWindow *fw : m_floatingWindows) {
         if (fw->windowHandle() == windowHandle)
             return fw;
@@ -694,6 +922,34 @@ void DockRegistry::ensureAllFloatingWidgetsAreMorphed()
 
 bool DockRegistry::eventFilter(QObject *watched, QEvent *event)
 {
+    // We get every event of the application, so check the event type first, before any other work.
+    switch (event->type()) {
+    case QEvent::Quit:
+    case QEvent::Expose:
+    case QEvent::WindowActivate:
+    case QEvent::WindowDeactivate:
+        break;
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseMove: {
+        // A handler might delete or unregister another one, so iterate a guarded copy.
+        // Backwards, as that's the order Qt calls qApp event filters in.
+        QVector<QPointer<WidgetResizeHandler>> handlers;
+        handlers.reserve(m_resizeHandlers.size());
+        for (WidgetResizeHandler *handler : qAsConst(m_resizeHandlers))
+            handlers.push_back(handler);
+
+        for (int i = handlers.size() - 1; i >= 0; --i) {
+            WidgetResizeHandler *handler = handlers.at(i);
+            if (handler && handler->eventFilter(watched, event))
+                return true;
+        }
+        break;
+    }
+    default:
+        return false;
+    }
+
     if (event->type() == QEvent::Quit && !m_isProcessingAppQuitEvent) {
         m_isProcessingAppQuitEvent = true;
         qApp->sendEvent(qApp, event);
@@ -702,11 +958,18 @@ bool DockRegistry::eventFilter(QObject *watched, QEvent *event)
     } else if (event->type() == QEvent::Expose) {
         if (auto windowHandle = qobject_cast<QWindow*>(watched)) {
             if (FloatingWindow *fw = floatingWindowForHandle(windowHandle)) {
-                // This floating window was exposed
-                m_floatingWindows.removeOne(fw);
-                m_floatingWindows.append(fw);
+                indexFloatingWindowHandle(fw, windowHandle);
+
+                // This floating window was exposed. Not when it's being hidden or minimized though.
+                if (windowHandle->isExposed())
+                    raiseFloatingWindow(fw);
             }
         }
+    } else if (event->type() == QEvent::WindowActivate || event->type() == QEvent::WindowDeactivate) {
+        // With QtWidgets every widget of the window gets this event, only the top-level is interesting
+        auto widget = qobject_cast<QWidgetOrQuick *>(watched);
+        if (widget && widget->isTopLevel())
+            onWindowActivationChanged(watched, event->type() == QEvent::WindowActivate);
     } else if (event->type() == QEvent::MouseButtonPress) {
         // When clicking on a MDI Frame we raise the window
         if (Frame *f = parentFrame(watched)) {
@@ -744,6 +1007,14 @@ bool DockRegistry::eventFilter(QObject *watched, QEvent *event)
     return false;
 }
 
+void DockRegistry::onWindowActivationChanged(QObject *window, bool active)
+{
+    for (DockWidgetBase *dw : qAsConst(m_dockWidgets)) {
+        if (dw->window() == window)
+            Q_EMIT dw->windowActiveAboutToChange(active);
+    }
+}
+
 bool DockRegistry::onDockWidgetPressed(DockWidgetBase *dw, QMouseEvent *ev)
 {
     // Here we implement "auto-hide". If there's a overlayed dock widget, we hide it if some other
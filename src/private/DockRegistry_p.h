@@ -30,10 +30,12 @@ namespace KDDockWidgets
 {
 
 class FloatingWindow;
+class FocusScope;
 class Frame;
 class LayoutWidget;
 class MainWindowMDI;
 class SideBar;
+class WidgetResizeHandler;
 struct WindowBeingDragged;
 
 class DOCKS_EXPORT DockRegistry : public QObject
@@ -50,6 +52,36 @@ public:
     };
     Q_DECLARE_FLAGS(DockByNameFlags, DockByNameFlag)
 
+    /// @brief Object counts and estimated bytes of a main window's or floating window's layout
+    struct LayoutMemoryUsage {
+        QString name; ///< The main window's unique name, or "floating:" + its first dock widget's
+        int items = 0; ///< Leaf items, including placeholders
+        int placeholders = 0; ///< Leaf items not holding a visible Frame
+        int containers = 0;
+        int separators = 0;
+        int frames = 0;
+        int dockWidgets = 0;
+        int placeholderRefs = 0; ///< Dock widget positions pointing to an item in this layout
+        qint64 estimatedBytes = 0;
+    };
+
+    /**
+     * @brief What KDDockWidgets itself costs, see memoryReport()
+     *
+     * Bytes are estimated with the sizeof() of our own classes. Qt's private data, like
+     * QWidgetPrivate, and the user's widgets aren't accounted.
+     */
+    struct MemoryReport {
+        QVector<LayoutMemoryUsage> mainWindows;
+        QVector<LayoutMemoryUsage> floatingWindows;
+        int dockWidgets = 0;
+        int closedDockWidgets = 0;
+        int placeholderRefs = 0; ///< All dock widget positions, in any layout
+        int danglingPlaceholderRefs = 0; ///< Positions whose item was already deleted
+        int layoutSaverDockWidgets = 0; ///< Cached in LayoutSaver::DockWidget::s_dockWidgets
+        qint64 estimatedBytes = 0; ///< Total, including the layouts above
+    };
+
     static DockRegistry *self();
     ~DockRegistry();
     void registerDockWidget(DockWidgetBase *);
@@ -61,12 +93,23 @@ public:
     void registerFloatingWindow(FloatingWindow *);
     void unregisterFloatingWindow(FloatingWindow *);
 
+    ///@brief Like unregisterFloatingWindow(), but never deletes the registry, even if it's empty now.
+    /// For windows going into the pool, which is usually filled before any dock widget exists.
+    void unregisterPooledFloatingWindow(FloatingWindow *);
+
     void registerLayout(LayoutWidget *);
     void unregisterLayout(LayoutWidget *);
 
     void registerFrame(Frame *);
     void unregisterFrame(Frame *);
 
+    ///@brief Registers a non top-level WidgetResizeHandler, which is interested in all the
+    /// application's mouse events. It's unregistered automatically when destroyed.
+    ///
+    /// DockRegistry's event filter on qApp dispatches to whoever is interested, so that the
+    /// cost per event doesn't grow with the amount of dock widgets or frames.
+    void registerResizeHandler(WidgetResizeHandler *);
+
     Q_INVOKABLE KDDockWidgets::DockWidgetBase *focusedDockWidget() const;
 
     Q_INVOKABLE bool containsDockWidget(const QString &uniqueName) const;
@@ -228,6 +271,10 @@ public:
     ///@brief Returns the Frame which is being resized in a MDI layout. nullptr if none
     Frame *frameInMDIResize() const;
 
+    ///@brief Walks all layouts, frames and dock widget positions and returns how many objects
+    /// we hold and roughly how much memory they use. Useful to find leaks or placeholders piling up.
+    MemoryReport memoryReport() const;
+
 Q_SIGNALS:
     /// @brief emitted when a main window or a floating window change screen
     void windowChangedScreen(QWindow *);
@@ -244,18 +291,47 @@ private:
     friend class FocusScope;
     explicit DockRegistry(QObject *parent = nullptr);
     bool onDockWidgetPressed(DockWidgetBase *dw, QMouseEvent *);
+    void onWindowActivationChanged(QObject *window, bool active);
+    void registerFocusScope(FocusScope *, QWidgetAdapter *scopeWidget);
+    void unregisterFocusScope(QWidgetAdapter *scopeWidget);
+    ///@brief For scopes which already contain the focus object when created, so they're told when they lose it
+    void registerFocusedScope(QWidgetAdapter *scopeWidget);
     void onFocusObjectChanged(QObject *obj);
     void maybeDelete();
     void setFocusedDockWidget(DockWidgetBase *);
 
+    ///@brief Called when @p fw is exposed, so it's found by floatingWindowForHandle() without a scan
+    void indexFloatingWindowHandle(FloatingWindow *fw, QWindow *windowHandle);
+    void unindexFloatingWindowHandle(QWindow *windowHandle);
+
+    ///@brief Moves @p fw to the end of m_floatingWindows, which is sorted by z-order
+    void raiseFloatingWindow(FloatingWindow *fw);
+
     bool m_isProcessingAppQuitEvent = false;
     DockWidgetBase::List m_dockWidgets;
     MainWindowBase::List m_mainWindows;
     QList<Frame*> m_frames;
     QVector<FloatingWindow*> m_floatingWindows;
+
+    struct IndexedFloatingWindow {
+        FloatingWindow *floatingWindow;
+        QMetaObject::Connection windowDestroyedConnection;
+    };
+
+    ///@brief The floating windows that were exposed, indexed by their QWindow
+    /// Entries are removed when the QWindow is destroyed, so they're never stale.
+    QHash<const QWindow *, IndexedFloatingWindow> m_floatingWindowsByHandle;
     QVector<LayoutWidget *> m_layouts;
+    QVector<WidgetResizeHandler *> m_resizeHandlers;
     QPointer<DockWidgetBase> m_focusedDockWidget;
 
+    ///@brief All FocusScopes, indexed by their widget. So a single walk up the parents of the
+    /// focus object finds the scopes containing it.
+    QHash<const QObject *, FocusScope *> m_focusScopes;
+
+    ///@brief The widgets of the scopes that contain the current focus object
+    QVector<const QObject *> m_focusedScopes;
+
     ///@brief Dock widget id remapping, used by LayoutSaver
     ///
     /// When LayoutSaver is trying to restore dock widget "foo", but it doesn't exist, it will
@@ -14,6 +14,7 @@
 
 #include "DockWidgetBase.h"
 #include "SideBar_p.h"
+#include "AffinityMask_p.h"
 #include "DockRegistry_p.h"
 #include "Position_p.h"
 #include "FloatingWindow_p.h"
@@ -85,12 +86,25 @@ public:
     void forceClose();
     QPoint defaultCenterPosForFloating();
 
-    bool eventFilter(QObject *watched, QEvent *event) override;
-
     void updateTitle();
     void toggle(bool enabled);
     void updateToggleAction();
     void updateFloatAction();
+
+    ///@brief Returns the toggle action, creating it on first use
+    QAction *toggleAction();
+
+    ///@brief Returns the float action, creating it on first use
+    QAction *floatAction();
+
+    ///@brief Called when the float action's checked state changes, even if it wasn't created yet
+    void onFloatingChecked(bool checked);
+
+    ///@brief Updates isSuspended(), called when the dock widget is shown, hidden or its tab changes
+    void updateSuspended();
+
+    ///@brief Applies Config::Flag_SuspendHiddenDockWidgets to @p guest
+    void applySuspendedState(QWidgetOrQuick *guest, bool suspended);
     void onDockWidgetShown();
     void onDockWidgetHidden();
     void show();
@@ -138,6 +152,7 @@ public:
 
     const QString name;
     QStringList affinities;
+    AffinityMask affinityMask; // same as affinities, interned
     QString title;
     QIcon titleBarIcon;
     QIcon tabBarIcon;
@@ -145,8 +160,16 @@ public:
     DockWidgetBase *const q;
     DockWidgetBase::Options options;
     const LayoutSaverOptions layoutSaverOptions;
-    QAction *const toggleAction;
-    QAction *const floatAction;
+    // Most dock widgets never have their actions in a menu, so they are only created in
+    // toggleAction() and floatAction(). Until then their state lives in the booleans below.
+    QAction *m_toggleAction = nullptr;
+    QAction *m_floatAction = nullptr;
+    QIcon m_toggleActionIcon;
+    bool m_isOpen = false; // toggleAction's checked state
+    bool m_isFloatingChecked = false; // floatAction's checked state
+    bool m_isSuspended = true; // A new dock widget is closed
+    bool m_guestVisible = true; // The guest's visibility as set by the app, restored when resuming (QtQuick)
+    bool m_guestUpdatesEnabled = true; // Same, for updatesEnabled (QtWidgets)
     LastPositions m_lastPositions;
     bool m_processingToggleAction = false;
     bool m_updatingToggleAction = false;
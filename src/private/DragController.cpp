@@ -21,12 +21,14 @@
 #include "WidgetResizeHandler_p.h"
 #include "Config.h"
 #include "MDILayoutWidget_p.h"
+#include "Tracer_p.h"
 
 #include <QMouseEvent>
 #include <QGuiApplication>
 #include <QCursor>
 #include <QWindow>
 #include <QDrag>
+#include <QElapsedTimer>
 #include <QScopedValueRollback>
 
 #if defined(Q_OS_WIN)
@@ -134,10 +136,20 @@ State *MinimalStateMachine::currentState() const
 void MinimalStateMachine::setCurrentState(State *state)
 {
     if (state != m_currentState) {
-        if (m_currentState)
+        if (m_currentState) {
             m_currentState->onExit();
 
+            // Each state shows as a span, from entry to exit
+            if (Debug::Tracer::isEnabled()) {
+                const qint64 now = Debug::Tracer::now();
+                Debug::Tracer::addSpan(m_currentState->metaObject()->className(),
+                                       m_currentStateEnteredAt, now - m_currentStateEnteredAt);
+            }
+        }
+
         m_currentState = state;
+        if (Debug::Tracer::isEnabled())
+            m_currentStateEnteredAt = Debug::Tracer::now();
 
         if (state)
             state->onEntry();
@@ -270,6 +282,8 @@ StateDragging::~StateDragging() = default;
 void StateDragging::onEntry()
 {
     m_maybeCancelDrag.start();
+    q->m_lastDragMoveNsecs = 0;
+    q->m_maxDragMoveNsecs = 0;
 
     if (DockWidgetBase *dw = q->m_draggable->singleDockWidget()) {
         // When we start to drag a floating window which has a single dock widget, we save the position
@@ -691,7 +705,7 @@ bool DragController::eventFilter(QObject *o, QEvent *e)
     if (m_nonClientDrag && e->type() == QEvent::Move) {
         // On Windows, non-client mouse moves are only sent at the end, so we must fake it:
         qCDebug(mouseevents) << "DragController::eventFilter e=" << e->type() << "; o=" << o;
-        activeState()->handleMouseMove(QCursor::pos());
+        handleMouseMove(QCursor::pos());
         return MinimalStateMachine::eventFilter(o, e);
     }
 
@@ -753,7 +767,7 @@ bool DragController::eventFilter(QObject *o, QEvent *e)
         return activeState()->handleMouseButtonRelease(Qt5Qt6Compat::eventGlobalPos(me));
     case QEvent::NonClientAreaMouseMove:
     case QEvent::MouseMove:
-        return activeState()->handleMouseMove(Qt5Qt6Compat::eventGlobalPos(me));
+        return handleMouseMove(Qt5Qt6Compat::eventGlobalPos(me));
     case QEvent::MouseButtonDblClick:
     case QEvent::NonClientAreaMouseButtonDblClick:
         return activeState()->handleMouseDoubleClick();
@@ -764,6 +778,30 @@ bool DragController::eventFilter(QObject *o, QEvent *e)
     return MinimalStateMachine::eventFilter(o, e);
 }
 
+bool DragController::handleMouseMove(QPoint globalPos)
+{
+    if (!isDragging())
+        return activeState()->handleMouseMove(globalPos);
+
+    QElapsedTimer timer;
+    timer.start();
+    const bool result = activeState()->handleMouseMove(globalPos);
+    m_lastDragMoveNsecs = timer.nsecsElapsed();
+    m_maxDragMoveNsecs = qMax(m_maxDragMoveNsecs, m_lastDragMoveNsecs);
+
+    return result;
+}
+
+qint64 DragController::dbg_lastDragMoveNsecs() const
+{
+    return m_lastDragMoveNsecs;
+}
+
+qint64 DragController::dbg_maxDragMoveNsecs() const
+{
+    return m_maxDragMoveNsecs;
+}
+
 StateBase *DragController::activeState() const
 {
     return static_cast<StateBase *>(currentState());
@@ -889,13 +927,13 @@ WidgetType *DragController::qtTopLevelUnderCursor() const
 }
 
 static DropArea* deepestDropAreaInTopLevel(WidgetType *topLevel, QPoint globalPos,
-                                           const QStringList &affinities)
+                                           const AffinityMask &affinities)
 {
     const auto localPos = topLevel->mapFromGlobal(globalPos);
     auto w = topLevel->childAt(localPos.x(), localPos.y());
     while (w) {
         if (auto dt = qobject_cast<DropArea *>(w)) {
-            if (DockRegistry::self()->affinitiesMatch(dt->affinities(), affinities))
+            if (dt->affinityMask().matches(affinities))
                 return dt;
         }
         w = KDDockWidgets::Private::parentWidget(w);
@@ -910,10 +948,10 @@ DropArea *DragController::dropAreaUnderCursor() const
     if (!topLevel)
         return nullptr;
 
-    const QStringList affinities = m_windowBeingDragged->floatingWindow()->affinities();
+    const AffinityMask affinities = m_windowBeingDragged->floatingWindow()->affinityMask();
 
     if (auto fw = qobject_cast<FloatingWindow *>(topLevel)) {
-        if (DockRegistry::self()->affinitiesMatch(fw->affinities(), affinities))
+        if (fw->affinityMask().matches(affinities))
             return fw->dropArea();
     }
 
@@ -60,6 +60,7 @@ public:
 
 private:
     State *m_currentState = nullptr;
+    qint64 m_currentStateEnteredAt = 0; // For Debug::Tracer
 };
 
 class DOCKS_EXPORT DragController : public MinimalStateMachine
@@ -95,6 +96,13 @@ public:
     /// Experimental, internal, not for general use.
     void enableFallbackMouseGrabber();
 
+    ///@brief Returns how long the last mouse move took to process while dragging, in nanoseconds.
+    ///Used by the DebugWindow
+    qint64 dbg_lastDragMoveNsecs() const;
+
+    ///@brief Returns the slowest mouse move of the current, or last, drag. In nanoseconds.
+    qint64 dbg_maxDragMoveNsecs() const;
+
 Q_SIGNALS:
     void mousePressed();
     void manhattanLengthMove();
@@ -121,6 +129,7 @@ private:
     WidgetType *qtTopLevelUnderCursor() const;
     DropArea *dropAreaUnderCursor() const;
     Draggable *draggableForQObject(QObject *o) const;
+    bool handleMouseMove(QPoint globalPos);
     QPoint m_pressPos;
     QPoint m_offset;
 
@@ -132,6 +141,8 @@ private:
     bool m_nonClientDrag = false;
     FallbackMouseGrabber *m_fallbackMouseGrabber = nullptr;
     StateInternalMDIDragging *m_stateDraggingMDI = nullptr;
+    qint64 m_lastDragMoveNsecs = 0;
+    qint64 m_maxDragMoveNsecs = 0;
 };
 
 class StateBase : public State
@@ -54,11 +54,6 @@ DropArea::~DropArea()
     qCDebug(creation) << "~DropArea";
 }
 
-Frame::List DropArea::frames() const
-{
-    return findChildren<Frame *>(QString(), Qt::FindDirectChildrenOnly);
-}
-
 Frame *DropArea::frameContainingPos(QPoint globalPos) const
 {
     const Layouting::Item::List &items = this->items();
@@ -124,11 +119,11 @@ void DropArea::addDockWidget(DockWidgetBase *dw, Location location,
             // The frame only has this dock widget, and the frame is already in the layout. So move the frame instead
             frame = oldFrame;
         } else {
-            frame = Config::self().frameworkWidgetFactory()->createFrame();
+            frame = Config::self().frameworkWidgetFactory()->acquireFrame();
             frame->addWidget(dw);
         }
     } else {
-        frame = Config::self().frameworkWidgetFactory()->createFrame();
+        frame = Config::self().frameworkWidgetFactory()->acquireFrame();
         frame->addWidget(dw);
     }
 
@@ -167,6 +162,22 @@ QStringList DropArea::affinities() const
     return {};
 }
 
+AffinityMask DropArea::affinityMask() const
+{
+    if (mainWindow()) {
+        return m_mainWindowAffinityMask;
+    } else if (auto fw = floatingWindow()) {
+        return fw->affinityMask();
+    }
+
+    return {};
+}
+
+void DropArea::setMainWindowAffinityMask(const AffinityMask &mask)
+{
+    m_mainWindowAffinityMask = mask;
+}
+
 void DropArea::layoutParentContainerEqually(DockWidgetBase *dw)
 {
     Layouting::Item *item = itemForFrame(dw->d->frame());
@@ -316,7 +327,7 @@ bool DropArea::drop(QWidgetOrQuick *droppedWindow, KDDockWidgets::Location locat
         if (!validateAffinity(dock))
             return false;
 
-        auto frame = Config::self().frameworkWidgetFactory()->createFrame();
+        auto frame = Config::self().frameworkWidgetFactory()->acquireFrame();
         frame->addWidget(dock);
         addWidget(frame, location, relativeTo, DefaultSizeMode::FairButFloor);
     } else if (auto floatingWindow = qobject_cast<FloatingWindow *>(droppedWindow)) {
@@ -347,14 +358,16 @@ void DropArea::removeHover()
 template<typename T>
 bool DropArea::validateAffinity(T *window, Frame *acceptingFrame) const
 {
-    if (!DockRegistry::self()->affinitiesMatch(window->affinities(), affinities())) {
+    // This runs on every mouse move while dragging, so match the interned affinities
+    const AffinityMask windowAffinities = window->affinityMask();
+    if (!windowAffinities.matches(affinityMask())) {
         return false;
     }
 
     if (acceptingFrame) {
         // We're dropping into another frame (as tabbed), so also check the affinity of the frame
         // not only of the main window, which might be more forgiving
-        if (!DockRegistry::self()->affinitiesMatch(window->affinities(), acceptingFrame->affinities())) {
+        if (!windowAffinities.matches(acceptingFrame->affinityMask())) {
             return false;
         }
     }
@@ -48,7 +48,6 @@ public:
     DropIndicatorOverlayInterface::DropLocation hover(WindowBeingDragged *draggedWindow, QPoint globalPos);
     ///@brief Called when a user drops a widget via DND
     bool drop(WindowBeingDragged *droppedWindow, QPoint globalPos);
-    Frame::List frames() const;
 
     Layouting::Item *centralFrame() const;
     DropIndicatorOverlayInterface *dropIndicatorOverlay() const { return m_dropIndicatorOverlay; }
@@ -62,6 +61,11 @@ public:
     bool hasSingleFloatingFrame() const;
 
     QStringList affinities() const;
+    AffinityMask affinityMask() const;
+
+    ///@brief Called by MainWindowBase, which keeps its affinities interned, so we don't need to
+    void setMainWindowAffinityMask(const AffinityMask &);
+
     void layoutParentContainerEqually(DockWidgetBase *);
 private:
     Q_DISABLE_COPY(DropArea)
@@ -80,6 +84,7 @@ private:
 
     bool m_inDestructor = false;
     QString m_affinityName;
+    AffinityMask m_mainWindowAffinityMask; // See setMainWindowAffinityMask()
     DropIndicatorOverlayInterface *m_dropIndicatorOverlay = nullptr;
 };
 }
@@ -135,6 +135,11 @@ FloatingWindow::FloatingWindow(MainWindowBase *parent)
 
 FloatingWindow::FloatingWindow(Frame *frame, MainWindowBase *parent)
     : FloatingWindow(hackFindParentHarder(frame, parent))
+{
+    addInitialFrame(frame);
+}
+
+void FloatingWindow::addInitialFrame(Frame *frame)
 {
     m_disableSetVisible = true;
     // Adding a widget will trigger onFrameCountChanged, which triggers a setVisible(true).
@@ -144,6 +149,34 @@ FloatingWindow::FloatingWindow(Frame *frame, MainWindowBase *parent)
     m_disableSetVisible = false;
 }
 
+MainWindowBase *FloatingWindow::parentForFrame(Frame *frame, MainWindowBase *candidateParent)
+{
+    return actualParent(hackFindParentHarder(frame, candidateParent));
+}
+
+void FloatingWindow::prepareForPool()
+{
+    // It's not a real floating window until it has a frame
+    DockRegistry::self()->unregisterPooledFloatingWindow(this);
+
+    // Creating the native window is what makes the first show() slow, do it now
+    if (kddwUsesQtWidgets()) {
+        // Explicitly hidden, so it's not shown along with its main window
+        setVisible(false);
+        create();
+    } else if (QWindow *window = windowHandle()) {
+        window->create();
+    }
+}
+
+void FloatingWindow::adoptFrame(Frame *frame, MainWindowBase *candidateParent)
+{
+    // Pooled windows have no parent, as we can't know which main window the frame belongs to
+    setParentMainWindow(parentForFrame(frame, candidateParent));
+    DockRegistry::self()->registerFloatingWindow(this);
+    addInitialFrame(frame);
+}
+
 FloatingWindow::~FloatingWindow()
 {
     m_inDtor = true;
@@ -401,6 +434,12 @@ QStringList FloatingWindow::affinities() const
     return frames.isEmpty() ? QStringList() : frames.constFirst()->affinities();
 }
 
+AffinityMask FloatingWindow::affinityMask() const
+{
+    auto frames = this->frames();
+    return frames.isEmpty() ? AffinityMask() : frames.constFirst()->affinityMask();
+}
+
 void FloatingWindow::updateTitleAndIcon()
 {
     QString title;
@@ -412,6 +451,10 @@ void FloatingWindow::updateTitleAndIcon()
     } else {
         title = qApp->applicationName();
     }
+
+    if (title == m_titleBar->title() && icon.cacheKey() == m_titleBar->icon().cacheKey())
+        return; // Nothing changed, don't bother the window manager
+
     m_titleBar->setTitle(title);
     m_titleBar->setIcon(icon);
 
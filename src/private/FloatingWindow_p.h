@@ -137,6 +137,7 @@ public:
     void updateTitleBarVisibility();
 
     QStringList affinities() const;
+    AffinityMask affinityMask() const;
 
     /**
      * Returns the drag rect in global coordinates. This is usually the title bar rect.
@@ -174,6 +175,10 @@ public:
     ///be open ended
     static Qt::WindowFlags s_windowFlagsOverride;
 
+    ///@brief Returns the main window a FloatingWindow holding @p frame gets parented to
+    ///@param candidateParent the parent suggested by the caller, if any
+    static MainWindowBase *parentForFrame(Frame *frame, MainWindowBase *candidateParent = nullptr);
+
 Q_SIGNALS:
     void activatedChanged();
     void numFramesChanged();
@@ -181,6 +186,10 @@ Q_SIGNALS:
 protected:
     void maybeCreateResizeHandler();
 
+    ///@brief Sets the main window this floating window stays on top of. See parentForFrame()
+    ///Called when a window from FrameworkWidgetFactory's pool gets used, as pooled windows have no parent.
+    virtual void setParentMainWindow(MainWindowBase *) {}
+
 #if defined(Q_OS_WIN) && defined(KDDOCKWIDGETS_QTWIDGETS)
     bool nativeEvent(const QByteArray &eventType, void *message, Qt5Qt6Compat::qintptr *result) override;
 #endif
@@ -192,6 +201,19 @@ protected:
     TitleBar *const m_titleBar;
 private:
     Q_DISABLE_COPY(FloatingWindow)
+    friend class FrameworkWidgetFactory;
+
+    ///@brief Called when this empty window is put into FrameworkWidgetFactory's pool.
+    ///Unregisters it and creates the native window, so it's ready to be shown.
+    void prepareForPool();
+
+    ///@brief Called when this window is taken from the pool, to hold @p frame
+    ///@param candidateParent the parent suggested by the caller, see parentForFrame()
+    void adoptFrame(Frame *frame, MainWindowBase *candidateParent);
+
+    ///@brief Adds the first frame, without showing the window yet
+    void addInitialFrame(Frame *frame);
+
     QSize maxSizeHint() const;
     void updateSizeConstraints();
     void onFrameCountChanged(int count);
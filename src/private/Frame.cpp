@@ -74,7 +74,8 @@ Frame::Frame(QWidgetOrQuick *parent, FrameOptions options, int userType)
 Frame::~Frame()
 {
     m_inDtor = true;
-    s_dbg_numFrames--;
+    if (!m_isPooled) // Pooled frames were already uncounted
+        s_dbg_numFrames--;
     if (m_layoutItem)
         m_layoutItem->unref();
 
@@ -89,6 +90,9 @@ Frame::~Frame()
 
 void Frame::updateTitleAndIcon()
 {
+    // Whatever was scheduled is done now
+    m_titleAndIconUpdatePending = false;
+
     if (DockWidgetBase *dw = currentDockWidget()) {
         m_titleBar->setTitle(dw->title());
         m_titleBar->setIcon(dw->icon());
@@ -106,9 +110,22 @@ void Frame::updateTitleAndIcon()
     }
 }
 
+void Frame::scheduleUpdateTitleAndIcon()
+{
+    if (m_titleAndIconUpdatePending)
+        return;
+
+    m_titleAndIconUpdatePending = true;
+    QTimer::singleShot(0, this, [this] {
+        if (m_titleAndIconUpdatePending && !m_inDtor)
+            updateTitleAndIcon();
+    });
+}
+
 void Frame::onDockWidgetTitleChanged()
 {
-    updateTitleAndIcon();
+    // The tab is cheap to update, but the title bars, and the floating window, are coalesced
+    scheduleUpdateTitleAndIcon();
 
     if (!m_inCtor) { // don't call pure virtual in ctor
         if (auto dw = qobject_cast<DockWidgetBase*>(sender())) {
@@ -191,13 +208,13 @@ FloatingWindow* Frame::detachTab(DockWidgetBase *dockWidget)
     QRect r = dockWidget->geometry();
     removeWidget(dockWidget);
 
-    auto newFrame = Config::self().frameworkWidgetFactory()->createFrame();
+    auto newFrame = Config::self().frameworkWidgetFactory()->acquireFrame();
     const QPoint globalPoint = mapToGlobal(QPoint(0, 0));
     newFrame->addWidget(dockWidget);
 
     // We're potentially already dead at this point, as frames with 0 tabs auto-destruct. Don't access members from this point.
 
-    auto floatingWindow = Config::self().frameworkWidgetFactory()->createFloatingWindow(newFrame);
+    auto floatingWindow = Config::self().frameworkWidgetFactory()->acquireFloatingWindow(newFrame);
     r.moveTopLeft(globalPoint);
     floatingWindow->setSuggestedGeometry(r, SuggestedGeometryHint_GeometryIsFromDocked);
     floatingWindow->show();
@@ -283,6 +300,10 @@ void Frame::onDockWidgetCountChanged()
 
 void Frame::onCurrentTabChanged(int index)
 {
+    // The previous tab isn't visible anymore
+    for (DockWidgetBase *dw : dockWidgets())
+        dw->d->updateSuspended();
+
     if (index != -1) {
         if (auto dock = dockWidgetAt(index)) {
             Q_EMIT currentDockWidgetChanged(dock);
@@ -382,23 +403,60 @@ const DockWidgetBase::List Frame::dockWidgets() const
     if (m_inCtor || m_inDtor)
         return {};
 
-    DockWidgetBase::List dockWidgets;
-    const int count = dockWidgetCount();
-    dockWidgets.reserve(count);
-    for (int i = 0; i < count; ++i)
-        dockWidgets << dockWidgetAt(i);
-
-    return dockWidgets;
+    return m_dockWidgets;
 }
 
 bool Frame::containsDockWidget(DockWidgetBase *dockWidget) const
 {
+    if (m_inCtor || m_inDtor)
+        return false;
+
+    return m_dockWidgetsSet.contains(dockWidget);
+}
+
+void Frame::onDockWidgetInserted(int index)
+{
+    if (m_inCtor || m_inDtor)
+        return;
+
+    DockWidgetBase *dw = dockWidgetAt(index);
+    m_dockWidgets.insert(index, dw);
+    m_dockWidgetsSet.insert(dw);
+    checkDockWidgetsIndex();
+}
+
+void Frame::onDockWidgetRemoved(int index)
+{
+    if (m_inCtor || m_inDtor)
+        return;
+
+    // The dock widget might be being deleted, only its address is used
+    m_dockWidgetsSet.remove(m_dockWidgets.takeAt(index));
+    checkDockWidgetsIndex();
+}
+
+void Frame::onDockWidgetMoved(int from, int to)
+{
+    if (m_inCtor || m_inDtor)
+        return;
+
+    m_dockWidgets.move(from, to);
+    checkDockWidgetsIndex();
+}
+
+void Frame::checkDockWidgetsIndex() const
+{
+#ifdef DOCKS_DEVELOPER_MODE
     const int count = dockWidgetCount();
-    for (int i = 0, e = count; i != e; ++i) {
-        if (dockWidget == dockWidgetAt(i))
-            return true;
+    bool inSync = m_dockWidgets.size() == count && m_dockWidgetsSet.size() == count;
+    for (int i = 0; inSync && i < count; ++i)
+        inSync = m_dockWidgets.at(i) == dockWidgetAt(i);
+
+    if (!inSync) {
+        qWarning() << Q_FUNC_INFO << "Dock widgets out of sync with the tabs" << this << m_dockWidgets;
+        Q_ASSERT(false);
     }
-    return false;
+#endif
 }
 
 FloatingWindow *Frame::floatingWindow() const
@@ -560,6 +618,15 @@ QStringList Frame::affinities() const
     }
 }
 
+AffinityMask Frame::affinityMask() const
+{
+    if (isEmpty()) {
+        return {};
+    } else {
+        return dockWidgetAt(0)->d->affinityMask;
+    }
+}
+
 void Frame::setLayoutWidget(LayoutWidget *dt)
 {
     if (dt == m_layoutWidget)
@@ -642,7 +709,7 @@ Frame *Frame::deserialize(const LayoutSaver::Frame &f)
     if (!f.isValid())
         return nullptr;
 
-    auto frame = Config::self().frameworkWidgetFactory()->createFrame(/*parent=*/nullptr, FrameOptions(f.options));
+    auto frame = Config::self().frameworkWidgetFactory()->acquireFrame(/*parent=*/nullptr, FrameOptions(f.options));
     frame->setObjectName(f.objectName);
 
     for (const auto &savedDock : qAsConst(f.dockWidgets)) {
@@ -682,10 +749,56 @@ void Frame::scheduleDeleteLater()
     m_beingDeleted = true;
     QTimer::singleShot(0, this, [this] {
         // Can't use deleteLater() here due to QTBUG-83030 (deleteLater() never delivered if triggered by a sendEvent() before event loop starts)
-        delete this;
+        if (!m_beingDeleted) // Was recycled meanwhile
+            return;
+
+        if (!Config::self().frameworkWidgetFactory()->releaseFrame(this))
+            delete this;
     });
 }
 
+bool Frame::prepareForReuse()
+{
+    if (!isEmpty() || isCentralFrame() || m_inDtor)
+        return false;
+
+    // Same cleanup as the destructor. The layout item becomes a placeholder, if still referenced.
+    QPointer<Layouting::Item> item = m_layoutItem;
+    setLayoutItem(nullptr);
+    if (item)
+        item->releaseGuest();
+
+    QWidgetAdapter::setParent(nullptr);
+    QWidgetAdapter::setVisible(false);
+    setLayoutWidget(nullptr);
+    setAllowedResizeSides({});
+
+    m_titleBar->setTitle(QString());
+    m_titleBar->setIcon(QIcon());
+    setObjectName(QString());
+    m_titleAndIconUpdatePending = false;
+    resetFocusedWidget();
+
+    DockRegistry::self()->unregisterFrame(this);
+    m_beingDeleted = false;
+    m_isPooled = true;
+    s_dbg_numFrames--;
+
+    return true;
+}
+
+void Frame::reuse(QWidgetOrQuick *parent, FrameOptions options)
+{
+    s_dbg_numFrames++;
+    m_isPooled = false;
+    m_options = actualOptions(options);
+    applyOptions();
+    DockRegistry::self()->registerFrame(this);
+
+    QWidgetAdapter::setParent(parent);
+    setLayoutWidget(qobject_cast<LayoutWidget *>(QWidgetAdapter::parentWidget()));
+}
+
 QSize Frame::dockWidgetsMinSize() const
 {
     QSize size = Layouting::Item::hardcodedMinimumSize;
@@ -25,10 +25,12 @@
 #include "kddockwidgets/DockWidgetBase.h"
 #include "kddockwidgets/LayoutSaver.h"
 #include "multisplitter/Widget.h"
+#include "AffinityMask_p.h"
 
 #include <QVector>
 #include <QDebug>
 #include <QPointer>
+#include <QSet>
 
 class TestDocks;
 
@@ -116,6 +118,11 @@ public:
     TabWidget *tabWidget() const;
 
     void updateTitleAndIcon();
+
+    ///@brief Calls updateTitleAndIcon() once, in the next event loop iteration
+    /// Dock widgets changing their title often would otherwise relayout the title bars each time
+    void scheduleUpdateTitleAndIcon();
+
     void onDockWidgetTitleChanged();
     void updateTitleBarVisibility();
     void updateFloatingActions();
@@ -234,6 +241,9 @@ public:
 
     QStringList affinities() const;
 
+    ///@brief Same as affinities(), but interned. Cheaper to match.
+    AffinityMask affinityMask() const;
+
     ///@brief sets the layout item that either contains this Frame in the layout or is a placeholder
     void setLayoutItem(Layouting::Item *item) override;
 
@@ -316,6 +326,11 @@ protected:
      */
     QSize biggestDockWidgetMaxSize() const;
 
+    ///@brief Applies the options() that need more than being read, like tab bar auto-hiding.
+    /// Called by the constructor of derived classes, and again when a pooled frame is reused with
+    /// different options.
+    virtual void applyOptions() {}
+
     virtual void removeWidget_impl(DockWidgetBase *) = 0;
     virtual int indexOfDockWidget_impl(const DockWidgetBase *) = 0;
     virtual int currentIndex_impl() const = 0;
@@ -338,21 +353,45 @@ private:
     Q_DISABLE_COPY(Frame)
     friend class ::TestDocks;
     friend class TabWidget;
+    friend class FrameworkWidgetFactory;
 
     void scheduleDeleteLater();
+
+    ///@brief Resets the frame so it can be handed out again by FrameworkWidgetFactory::acquireFrame()
+    ///Returns false if the frame can't be recycled, in which case it should just be deleted.
+    bool prepareForReuse();
+
+    ///@brief Called by FrameworkWidgetFactory::acquireFrame() when handing out a recycled frame
+    void reuse(QWidgetOrQuick *parent, FrameOptions);
+
     bool event(QEvent *) override;
 
     /// @brief Sets the LayoutWidget which this frame is in
     void setLayoutWidget(LayoutWidget *);
 
+    ///@brief Called by TabWidget whenever a tab is added, removed or moved, to keep the list of
+    /// dock widgets, and the index used by containsDockWidget(), in sync without walking the tabs
+    void onDockWidgetInserted(int index);
+    void onDockWidgetRemoved(int index);
+    void onDockWidgetMoved(int from, int to);
+
+    ///@brief Developer-mode check that the above didn't miss a change
+    void checkDockWidgetsIndex() const;
+
     LayoutWidget *m_layoutWidget = nullptr;
     WidgetResizeHandler *m_resizeHandler = nullptr;
     FrameOptions m_options = FrameOption_None;
     QPointer<Layouting::Item> m_layoutItem;
     bool m_updatingTitleBar = false;
     bool m_beingDeleted = false;
+    bool m_isPooled = false; // See FrameworkWidgetFactory::releaseFrame()
+    bool m_titleAndIconUpdatePending = false;
     int m_userType = 0;
     QMetaObject::Connection m_visibleWidgetCountChangedConnection;
+
+    // Frames can have hundreds of tabs, don't ask the tab widget for each one every time
+    DockWidgetBase::List m_dockWidgets;
+    QSet<const DockWidgetBase *> m_dockWidgetsSet;
 };
 
 }
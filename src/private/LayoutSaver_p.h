@@ -375,7 +375,24 @@ public:
     InternalRestoreOptions m_restoreOptions = {};
     QStringList m_affinityNames;
 
+    ///@brief How long each phase of the last restoreLayout() took, in nanoseconds.
+    ///Shown by the DebugWindow. Phases that weren't reached, due to an error, stay at 0.
+    struct RestoreTimings {
+        qint64 parse = 0;
+        qint64 clear = 0;
+        qint64 mainWindows = 0;
+        qint64 floatingWindows = 0;
+        qint64 closedDockWidgets = 0;
+        qint64 placeholders = 0;
+
+        qint64 total() const
+        {
+            return parse + clear + mainWindows + floatingWindows + closedDockWidgets + placeholders;
+        }
+    };
+
     static bool s_restoreInProgress;
+    static RestoreTimings s_lastRestoreTimings;
 };
 }
 
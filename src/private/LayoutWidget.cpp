@@ -18,6 +18,10 @@
 #include "MainWindowBase.h"
 #include "Position_p.h"
 
+#include <QTimer>
+
+#include <algorithm>
+
 using namespace KDDockWidgets;
 
 
@@ -64,8 +68,13 @@ void LayoutWidget::setRootItem(Layouting::ItemContainer *root)
     m_rootItem = root;
     connect(m_rootItem, &Layouting::ItemContainer::numVisibleItemsChanged, this,
             &MultiSplitter::visibleWidgetCountChanged);
+    connect(m_rootItem, &Layouting::ItemContainer::numVisibleItemsChanged, this,
+            &LayoutWidget::scheduleCompactPlaceholders);
     connect(m_rootItem, &Layouting::ItemContainer::minSizeChanged, this,
             [this] { setMinimumSize(layoutMinimumSize()); });
+    connect(m_rootItem, &Layouting::ItemContainer::guestsChanged, this,
+            [this] { m_framesCacheValid = false; });
+    m_framesCacheValid = false;
 }
 
 QSize LayoutWidget::layoutMinimumSize() const
@@ -109,7 +118,7 @@ void LayoutWidget::dumpLayout() const
 void LayoutWidget::restorePlaceholder(DockWidgetBase *dw, Layouting::Item *item, int tabIndex)
 {
     if (item->isPlaceholder()) {
-        Frame *newFrame = Config::self().frameworkWidgetFactory()->createFrame(this);
+        Frame *newFrame = Config::self().frameworkWidgetFactory()->acquireFrame(this);
         item->restore(newFrame);
     }
 
@@ -134,6 +143,113 @@ void LayoutWidget::unrefOldPlaceholders(const Frame::List &framesBeingAdded) con
     }
 }
 
+/// @brief Returns the sibling of @p item closest to it, which dock widgets can restore to instead.
+/// Only leaves count, and not the ones in @p beingRemoved
+static Layouting::Item *closestSiblingLeaf(Layouting::Item *item, const QVector<Layouting::Item *> &beingRemoved)
+{
+    Layouting::ItemContainer *parent = item->parentContainer();
+    if (!parent)
+        return nullptr;
+
+    const Layouting::Item::List siblings = parent->childItems();
+    const int index = siblings.indexOf(item);
+    for (int distance = 1; distance < siblings.size(); ++distance) {
+        for (int candidateIndex : { index - distance, index + distance }) {
+            if (candidateIndex < 0 || candidateIndex >= siblings.size())
+                continue;
+
+            Layouting::Item *candidate = siblings.at(candidateIndex);
+            if (!candidate->isContainer() && !beingRemoved.contains(candidate))
+                return candidate;
+        }
+    }
+
+    return nullptr;
+}
+
+void LayoutWidget::scheduleCompactPlaceholders()
+{
+    if (m_compactPlaceholdersPending || (Config::self().flags() & Config::Flag_CompactPlaceholdersOnSave))
+        return;
+
+    if (Config::self().maxPlaceholdersPerLayout() <= 0 && Config::self().maxPlaceholderAge() <= 0)
+        return;
+
+    // Not right away, we're in the middle of closing or moving something
+    m_compactPlaceholdersPending = true;
+    QTimer::singleShot(0, this, [this] {
+        compactPlaceholders();
+    });
+}
+
+int LayoutWidget::compactPlaceholders()
+{
+    m_compactPlaceholdersPending = false;
+
+    const int maxCount = Config::self().maxPlaceholdersPerLayout();
+    const int maxAge = Config::self().maxPlaceholderAge();
+    if ((maxCount <= 0 && maxAge <= 0) || LayoutSaver::restoreInProgress())
+        return 0;
+
+    // Ages are read once, they keep changing while we sort
+    QVector<QPair<qint64, Layouting::Item *>> placeholders;
+    const Layouting::Item::List allItems = items();
+    for (Layouting::Item *item : allItems) {
+        if (item->isPlaceholder())
+            placeholders.push_back({ item->placeholderAge(), item });
+    }
+
+    std::stable_sort(placeholders.begin(), placeholders.end(), [] (const QPair<qint64, Layouting::Item *> &a,
+                                                                   const QPair<qint64, Layouting::Item *> &b) {
+        return a.first > b.first;
+    });
+
+    int numToRemove = maxCount > 0 ? qMax(0, placeholders.size() - maxCount) : 0;
+    if (maxAge > 0) {
+        while (numToRemove < placeholders.size() && placeholders.at(numToRemove).first > maxAge)
+            numToRemove++;
+
+        // Placeholders keep aging while nothing happens in the layout, so check again when the
+        // oldest one we're keeping expires
+        if (numToRemove < placeholders.size() && !(Config::self().flags() & Config::Flag_CompactPlaceholdersOnSave)) {
+            if (!m_placeholderAgeTimer) {
+                m_placeholderAgeTimer = new QTimer(this);
+                m_placeholderAgeTimer->setSingleShot(true);
+                connect(m_placeholderAgeTimer, &QTimer::timeout, this, &LayoutWidget::compactPlaceholders);
+            }
+            m_placeholderAgeTimer->start(int(maxAge - placeholders.at(numToRemove).first) + 1);
+        }
+    }
+
+    if (numToRemove == 0)
+        return 0;
+
+    QVector<Layouting::Item *> beingRemoved;
+    beingRemoved.reserve(numToRemove);
+    for (int i = 0; i < numToRemove; ++i)
+        beingRemoved.push_back(placeholders.at(i).second);
+
+    // Decide where everyone goes before touching the layout, as removing items reshapes the tree
+    QVector<QPair<Layouting::Item *, Layouting::Item *>> replacements;
+    replacements.reserve(numToRemove);
+    for (Layouting::Item *placeholder : qAsConst(beingRemoved))
+        replacements.push_back({ placeholder, closestSiblingLeaf(placeholder, beingRemoved) });
+
+    // The placeholder is deleted once the last dock widget stops pointing to it
+    const DockWidgetBase::List dockWidgets = DockRegistry::self()->dockwidgets();
+    for (const auto &replacement : qAsConst(replacements)) {
+        for (DockWidgetBase *dw : dockWidgets) {
+            const LastPositions &positions = dw->d->lastPositions();
+            if (positions.containsPlaceholder(replacement.first))
+                positions.replacePlaceholder(replacement.first, replacement.second);
+        }
+    }
+
+    qCDebug(placeholder) << Q_FUNC_INFO << "Removed" << numToRemove << "placeholders from" << this;
+
+    return numToRemove;
+}
+
 void LayoutWidget::setLayoutSize(QSize size)
 {
     if (size != this->size()) {
@@ -185,6 +301,7 @@ DockWidgetBase::List LayoutWidget::dockWidgets() const
 {
     DockWidgetBase::List dockWidgets;
     const Frame::List frames = this->frames();
+    dockWidgets.reserve(frames.size());
     for (Frame *frame : frames)
         dockWidgets << frame->dockWidgets();
 
@@ -204,17 +321,21 @@ Frame::List LayoutWidget::framesFrom(QWidgetOrQuick *frameOrMultiSplitter) const
 
 Frame::List LayoutWidget::frames() const
 {
+    if (m_framesCacheValid)
+        return m_cachedFrames;
+
     const Layouting::Item::List items = m_rootItem->items_recursive();
 
-    Frame::List result;
-    result.reserve(items.size());
+    m_cachedFrames.clear();
+    m_cachedFrames.reserve(items.size());
 
     for (Layouting::Item *item : items) {
         if (auto f = static_cast<Frame *>(item->guestAsQObject()))
-            result.push_back(f);
+            m_cachedFrames.push_back(f);
     }
 
-    return result;
+    m_framesCacheValid = true;
+    return m_cachedFrames;
 }
 
 void LayoutWidget::removeItem(Layouting::Item *item)
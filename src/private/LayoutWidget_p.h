@@ -31,6 +31,10 @@
 
 #include <QList>
 
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
 namespace Layouting {
 class Item;
 class Separator;
@@ -163,7 +167,10 @@ public:
     Layouting::Item *itemForFrame(const Frame *frame) const;
 
     /**
-     * @brief Returns this list of Frame objects contained in this layout
+     * @brief Returns this list of Frame objects contained in this layout, in layout order
+     *
+     * The list is cached and only rebuilt when frames are added or removed, so calling this
+     * repeatedly doesn't allocate. It's a copy, so it's fine to modify the layout while iterating.
      */
     QList<Frame *> frames() const;
 
@@ -180,6 +187,19 @@ public:
      */
     void updateSizeConstraints();
 
+    /**
+     * @brief Removes the placeholders exceeding Config::maxPlaceholdersPerLayout() or
+     * Config::maxPlaceholderAge(), oldest first.
+     *
+     * Dock widgets that pointed to a removed placeholder will restore as a tab of its closest
+     * sibling instead, if there's one. Otherwise they forget their position in this layout.
+     * Returns how many placeholders were removed.
+     *
+     * Runs after dock widgets close. With an age limit it also runs when the oldest remaining
+     * placeholder expires, so idle layouts are compacted too.
+     */
+    int compactPlaceholders();
+
     virtual bool deserialize(const LayoutSaver::MultiSplitter &);
     LayoutSaver::MultiSplitter serialize() const;
 
@@ -216,7 +236,12 @@ Q_SIGNALS:
     void visibleWidgetCountChanged(int count);
 
 private:
+    void scheduleCompactPlaceholders();
     bool m_inResizeEvent = false;
+    bool m_compactPlaceholdersPending = false;
+    QTimer *m_placeholderAgeTimer = nullptr; // See compactPlaceholders()
+    mutable bool m_framesCacheValid = false;
+    mutable QList<Frame *> m_cachedFrames; // See frames()
     Layouting::ItemContainer *m_rootItem = nullptr;
 };
 
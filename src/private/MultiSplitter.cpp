@@ -139,7 +139,7 @@ void MultiSplitter::addWidget(QWidgetOrQuick *w, Location location,
         newItem->setGuestWidget(frame);
     } else if (dw) {
         newItem = new Layouting::Item(this);
-        frame = Config::self().frameworkWidgetFactory()->createFrame();
+        frame = Config::self().frameworkWidgetFactory()->acquireFrame();
         newItem->setGuestWidget(frame);
         frame->addWidget(dw, option);
     } else if (auto ms = qobject_cast<MultiSplitter*>(w)) {
@@ -0,0 +1,124 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2021 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "PerformanceView_p.h"
+#include "DockRegistry_p.h"
+#include "DragController_p.h"
+#include "Frame_p.h"
+#include "LayoutSaver_p.h"
+#include "LayoutWidget_p.h"
+#include "multisplitter/Item_p.h"
+#include "multisplitter/Separator_p.h"
+
+#include <QFormLayout>
+#include <QLabel>
+
+using namespace KDDockWidgets;
+using namespace KDDockWidgets::Debug;
+
+/// @brief How often the counters are refreshed while the page is visible
+static const int s_refreshIntervalMs = 500;
+
+static QString nsecsToString(qint64 nsecs)
+{
+    return QStringLiteral("%1 ms").arg(nsecs / 1000000.0, 0, 'f', 2);
+}
+
+PerformanceView::PerformanceView(QWidget *parent)
+    : QWidget(parent)
+    , m_layout(new QFormLayout(this))
+    , m_frames(addRow(QStringLiteral("Frames")))
+    , m_separators(addRow(QStringLiteral("Separators")))
+    , m_items(addRow(QStringLiteral("Layout items")))
+    , m_placeholders(addRow(QStringLiteral("Placeholders")))
+    , m_dockWidgets(addRow(QStringLiteral("Dock widgets")))
+    , m_mainWindows(addRow(QStringLiteral("Main windows")))
+    , m_floatingWindows(addRow(QStringLiteral("Floating windows")))
+    , m_layouts(addRow(QStringLiteral("Layouts")))
+    , m_relayoutsPerSecond(addRow(QStringLiteral("Relayouts/s")))
+    , m_lastDragMove(addRow(QStringLiteral("Last drag move")))
+    , m_maxDragMove(addRow(QStringLiteral("Slowest drag move")))
+    , m_lastRestore(addRow(QStringLiteral("Last restore")))
+{
+    m_lastRestore->setTextFormat(Qt::PlainText);
+    m_refreshTimer.setInterval(s_refreshIntervalMs);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &PerformanceView::refresh);
+}
+
+QLabel *PerformanceView::addRow(const QString &name)
+{
+    auto label = new QLabel(this);
+    label->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    m_layout->addRow(name, label);
+    return label;
+}
+
+void PerformanceView::refresh()
+{
+    DockRegistry *registry = DockRegistry::self();
+
+    int numItems = 0;
+    int numPlaceholders = 0;
+    const auto layouts = registry->layouts();
+    for (LayoutWidget *layout : layouts) {
+        numItems += layout->count();
+        numPlaceholders += layout->placeholderCount();
+    }
+
+    m_frames->setNum(Frame::dbg_numFrames());
+    m_separators->setNum(Layouting::Separator::numSeparators());
+    m_items->setNum(numItems);
+    m_placeholders->setNum(numPlaceholders);
+    m_dockWidgets->setNum(registry->dockwidgets().size());
+    m_mainWindows->setNum(registry->mainwindows().size());
+    m_floatingWindows->setNum(registry->floatingWindows().size());
+    m_layouts->setNum(layouts.size());
+
+    const quint64 numRelayouts = Layouting::ItemBoxContainer::dbg_numRelayouts();
+    if (m_sinceLastRefresh.isValid()) {
+        const qint64 elapsed = qMax(qint64(1), m_sinceLastRefresh.elapsed());
+        m_relayoutsPerSecond->setText(QString::number((numRelayouts - m_lastNumRelayouts) * 1000.0 / elapsed, 'f', 1));
+    }
+    m_lastNumRelayouts = numRelayouts;
+    m_sinceLastRefresh.start();
+
+    DragController *dc = DragController::instance();
+    m_lastDragMove->setText(nsecsToString(dc->dbg_lastDragMoveNsecs()));
+    m_maxDragMove->setText(nsecsToString(dc->dbg_maxDragMoveNsecs()));
+
+    const LayoutSaver::Private::RestoreTimings &timings = LayoutSaver::Private::s_lastRestoreTimings;
+    const QStringList restoreLines = {
+        QStringLiteral("total: %1").arg(nsecsToString(timings.total())),
+        QStringLiteral("parse: %1").arg(nsecsToString(timings.parse)),
+        QStringLiteral("clear: %1").arg(nsecsToString(timings.clear)),
+        QStringLiteral("main windows: %1").arg(nsecsToString(timings.mainWindows)),
+        QStringLiteral("floating windows: %1").arg(nsecsToString(timings.floatingWindows)),
+        QStringLiteral("closed dock widgets: %1").arg(nsecsToString(timings.closedDockWidgets)),
+        QStringLiteral("placeholders: %1").arg(nsecsToString(timings.placeholders))
+    };
+    m_lastRestore->setText(restoreLines.join(QLatin1Char('\n')));
+}
+
+void PerformanceView::showEvent(QShowEvent *ev)
+{
+    QWidget::showEvent(ev);
+
+    // Don't count what happened while we weren't looking
+    m_sinceLastRefresh.invalidate();
+    refresh();
+    m_refreshTimer.start();
+}
+
+void PerformanceView::hideEvent(QHideEvent *ev)
+{
+    QWidget::hideEvent(ev);
+    m_refreshTimer.stop();
+}
@@ -0,0 +1,74 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2021 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+/**
+ * @file
+ * @brief Page showing live performance counters. Used for debugging only, so slowness can be
+ * diagnosed on a user's machine without a profiler.
+ *
+ * @author Sérgio Martins \<sergio.martins@kdab.com\>
+ */
+
+#ifndef PERFORMANCEVIEW_H
+#define PERFORMANCEVIEW_H
+
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QWidget>
+
+QT_BEGIN_NAMESPACE
+class QFormLayout;
+class QLabel;
+QT_END_NAMESPACE
+
+namespace KDDockWidgets {
+namespace Debug {
+
+class PerformanceView : public QWidget //clazy:exclude=missing-qobject-macro
+{
+public:
+    explicit PerformanceView(QWidget *parent = nullptr);
+
+    ///@brief Re-reads all counters. Called periodically while visible.
+    void refresh();
+
+protected:
+    void showEvent(QShowEvent *) override;
+    void hideEvent(QHideEvent *) override;
+
+private:
+    QLabel *addRow(const QString &name);
+
+    QFormLayout *const m_layout;
+    QTimer m_refreshTimer;
+
+    // For relayouts per second
+    QElapsedTimer m_sinceLastRefresh;
+    quint64 m_lastNumRelayouts = 0;
+
+    QLabel *m_frames;
+    QLabel *m_separators;
+    QLabel *m_items;
+    QLabel *m_placeholders;
+    QLabel *m_dockWidgets;
+    QLabel *m_mainWindows;
+    QLabel *m_floatingWindows;
+    QLabel *m_layouts;
+    QLabel *m_relayoutsPerSecond;
+    QLabel *m_lastDragMove;
+    QLabel *m_maxDragMove;
+    QLabel *m_lastRestore;
+};
+
+}
+}
+
+#endif
@@ -47,6 +47,11 @@ void Position::addPlaceholderItem(Layouting::Item *placeholder)
         removeNonMainWindowPlaceholders();
     }
 
+    appendPlaceholder(placeholder);
+}
+
+void Position::appendPlaceholder(Layouting::Item *placeholder)
+{
     // Make sure our list only contains valid placeholders. We save the result so we can disconnect from the lambda, since the Item might outlive LastPosition
     QMetaObject::Connection connection = QObject::connect(placeholder, &QObject::destroyed, placeholder, [this, placeholder] {
         removePlaceholder(placeholder);
@@ -117,6 +122,17 @@ void Position::removePlaceholder(Layouting::Item *placeholder)
     }), m_placeholders.end());
 }
 
+void Position::replacePlaceholder(Layouting::Item *placeholder, Layouting::Item *replacement)
+{
+    if (!containsPlaceholder(placeholder))
+        return;
+
+    if (replacement && !containsPlaceholder(replacement))
+        appendPlaceholder(replacement);
+
+    removePlaceholder(placeholder);
+}
+
 void Position::deserialize(const LayoutSaver::Position &lp)
 {
     for (const auto &placeholder : qAsConst(lp.placeholders)) {
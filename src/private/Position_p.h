@@ -113,7 +113,13 @@ public:
     ///@brief removes the Item @p placeholder
     void removePlaceholder(Layouting::Item *placeholder);
 
+    ///@brief Points to @p replacement instead of @p placeholder, if we had it.
+    /// @p replacement can be nullptr, in which case @p placeholder is just removed.
+    void replacePlaceholder(Layouting::Item *placeholder, Layouting::Item *replacement);
+
 private:
+    void appendPlaceholder(Layouting::Item *placeholder);
+
     friend inline QDebug operator<<(QDebug, const KDDockWidgets::Position::Ptr &);
 
     // The last places where this dock widget was (or is), so it can be restored when setFloating(false) or show() is called.
@@ -181,10 +187,24 @@ struct LastPositions
         lastPosition->removePlaceholders(hostWidget);
     }
 
+    bool containsPlaceholder(Layouting::Item *placeholder) const
+    {
+        return lastPosition->containsPlaceholder(placeholder);
+    }
+
+    void replacePlaceholder(Layouting::Item *placeholder, Layouting::Item *replacement) const
+    {
+        lastPosition->replacePlaceholder(placeholder, replacement);
+    }
+
     int lastTabIndex() const {
         return lastPosition->m_tabIndex;
     }
 
+    const std::vector<std::unique_ptr<ItemRef>> &placeholders() const {
+        return lastPosition->placeholders();
+    }
+
 private:
     QRect m_lastFloatingGeometry;
     QHash<SideBarLocation, QRect> m_lastOverlayedGeometries;
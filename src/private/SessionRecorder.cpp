@@ -0,0 +1,137 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2021 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "SessionRecorder_p.h"
+#include "DockRegistry_p.h"
+#include "FloatingWindow_p.h"
+#include "LayoutSaver.h"
+#include "Qt5Qt6Compat_p.h"
+
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonDocument>
+#include <QMouseEvent>
+#include <QWindow>
+#include <QDebug>
+
+using namespace KDDockWidgets;
+using namespace KDDockWidgets::Debug;
+
+static QVariantMap pointToVariantMap(QPoint pt)
+{
+    QVariantMap map;
+    map.insert(QStringLiteral("x"), pt.x());
+    map.insert(QStringLiteral("y"), pt.y());
+    return map;
+}
+
+SessionRecorder::SessionRecorder(const QString &filename, QObject *parent)
+    : QObject(parent)
+    , m_filename(filename)
+{
+    qApp->installEventFilter(this);
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &SessionRecorder::save);
+}
+
+SessionRecorder::~SessionRecorder()
+{
+}
+
+bool SessionRecorder::save() const
+{
+    if (m_events.isEmpty())
+        return true;
+
+    QFile file(m_filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << Q_FUNC_INFO << "Failed to open" << m_filename << file.errorString();
+        return false;
+    }
+
+    QVariantMap map;
+    map.insert(QStringLiteral("layout"), QJsonDocument::fromJson(m_initialLayout).toVariant());
+    map.insert(QStringLiteral("events"), m_events);
+    file.write(QJsonDocument::fromVariant(map).toJson());
+
+    return true;
+}
+
+QString SessionRecorder::keyForWindow(QWindow *window)
+{
+    if (MainWindowBase *mw = DockRegistry::self()->mainWindowForHandle(window))
+        return QStringLiteral("mainwindow:") + mw->uniqueName();
+
+    if (FloatingWindow *fw = DockRegistry::self()->floatingWindowForHandle(window)) {
+        const QVector<DockWidgetBase *> dockWidgets = fw->dockWidgets();
+        if (!dockWidgets.isEmpty())
+            return QStringLiteral("floating:") + dockWidgets.first()->uniqueName();
+    }
+
+    return {};
+}
+
+QWindow *SessionRecorder::windowForKey(const QString &key)
+{
+    const QString mainWindowPrefix = QStringLiteral("mainwindow:");
+    const QString floatingPrefix = QStringLiteral("floating:");
+
+    if (key.startsWith(mainWindowPrefix)) {
+        if (MainWindowBase *mw = DockRegistry::self()->mainWindowByName(key.mid(mainWindowPrefix.size())))
+            return mw->window()->windowHandle();
+    } else if (key.startsWith(floatingPrefix)) {
+        if (DockWidgetBase *dw = DockRegistry::self()->dockByName(key.mid(floatingPrefix.size())))
+            return dw->window()->windowHandle();
+    }
+
+    return nullptr;
+}
+
+bool SessionRecorder::eventFilter(QObject *watched, QEvent *event)
+{
+    switch (event->type()) {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseButtonDblClick:
+    case QEvent::MouseMove:
+        break;
+    default:
+        return false;
+    }
+
+    // Only record what the platform delivers to the window. Qt then dispatches it to the
+    // widget or item under the cursor, which is what we want to exercise when replaying.
+    auto window = qobject_cast<QWindow *>(watched);
+    if (!window || !event->spontaneous())
+        return false;
+
+    auto me = static_cast<QMouseEvent *>(event);
+    if (m_events.isEmpty()) {
+        if (event->type() != QEvent::MouseButtonPress)
+            return false;
+
+        LayoutSaver saver;
+        m_initialLayout = saver.serializeLayout();
+        m_elapsed.start();
+    }
+
+    QVariantMap map;
+    map.insert(QStringLiteral("time"), m_elapsed.elapsed());
+    map.insert(QStringLiteral("type"), int(event->type()));
+    map.insert(QStringLiteral("window"), keyForWindow(window));
+    map.insert(QStringLiteral("localPos"), pointToVariantMap(Qt5Qt6Compat::eventPos(me)));
+    map.insert(QStringLiteral("globalPos"), pointToVariantMap(Qt5Qt6Compat::eventGlobalPos(me)));
+    map.insert(QStringLiteral("button"), int(me->button()));
+    map.insert(QStringLiteral("buttons"), int(me->buttons()));
+    map.insert(QStringLiteral("modifiers"), int(me->modifiers()));
+    m_events.push_back(map);
+
+    return false;
+}
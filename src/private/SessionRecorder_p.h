@@ -0,0 +1,79 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2021 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+/**
+ * @file
+ * @brief Records the mouse events of an interactive session, so they can be replayed offscreen.
+ *
+ * @author Sérgio Martins \<sergio.martins@kdab.com\>
+ */
+
+#ifndef KD_SESSIONRECORDER_P_H
+#define KD_SESSIONRECORDER_P_H
+
+#include "kddockwidgets/docks_export.h"
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QVariantList>
+
+QT_BEGIN_NAMESPACE
+class QWindow;
+QT_END_NAMESPACE
+
+namespace KDDockWidgets {
+namespace Debug {
+
+/**
+ * @brief Records the mouse events the user feeds to our windows, for later replay.
+ *
+ * Events are captured at the QWindow level, before Qt dispatches them to DragController,
+ * the separators or WidgetResizeHandler, so replaying them exercises the exact same paths.
+ *
+ * Recording starts at the first mouse press, which is also when the starting layout is saved.
+ * The session is written to @p filename when the application quits.
+ *
+ * Enabled in developer-mode builds with KDDOCKWIDGETS_RECORD_SESSION=<file.json>.
+ * See tests/replay for the replayer.
+ */
+class DOCKS_EXPORT_FOR_UNIT_TESTS SessionRecorder : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SessionRecorder(const QString &filename, QObject *parent = nullptr);
+    ~SessionRecorder() override;
+
+    ///@brief Writes the recorded session to disk. Returns false on error.
+    bool save() const;
+
+    ///@brief Returns a key identifying @p window, which survives save and restore.
+    /// "mainwindow:<uniqueName>" or "floating:<uniqueName of the first dock widget>".
+    /// Returns an empty string if the window isn't ours.
+    static QString keyForWindow(QWindow *window);
+
+    ///@brief The inverse of keyForWindow(). Returns nullptr if nothing matches @p key.
+    static QWindow *windowForKey(const QString &key);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    Q_DISABLE_COPY(SessionRecorder)
+    const QString m_filename;
+    QByteArray m_initialLayout;
+    QVariantList m_events;
+    QElapsedTimer m_elapsed;
+};
+
+}
+}
+
+#endif
@@ -235,7 +235,7 @@ std::unique_ptr<WindowBeingDragged> TabWidget::makeWindow()
 
     const QPoint globalPoint = m_thisWidget->mapToGlobal(QPoint(0, 0));
 
-    auto floatingWindow = Config::self().frameworkWidgetFactory()->createFloatingWindow(m_frame);
+    auto floatingWindow = Config::self().frameworkWidgetFactory()->acquireFloatingWindow(m_frame);
     r.moveTopLeft(globalPoint);
     floatingWindow->setSuggestedGeometry(r, SuggestedGeometryHint_GeometryIsFromDocked);
     floatingWindow->show();
@@ -266,16 +266,23 @@ bool TabWidget::isMDI() const
     return m_frame && m_frame->isMDI();
 }
 
-void TabWidget::onTabInserted()
+void TabWidget::onTabInserted(int index)
 {
+    m_frame->onDockWidgetInserted(index);
     m_frame->onDockWidgetCountChanged();
 }
 
-void TabWidget::onTabRemoved()
+void TabWidget::onTabRemoved(int index)
 {
+    m_frame->onDockWidgetRemoved(index);
     m_frame->onDockWidgetCountChanged();
 }
 
+void TabWidget::onTabMoved(int from, int to)
+{
+    m_frame->onDockWidgetMoved(from, to);
+}
+
 void TabWidget::onCurrentTabChanged(int index)
 {
     Q_UNUSED(index);
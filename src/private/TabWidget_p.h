@@ -190,8 +190,10 @@ public:
     virtual void countChanged() {};
 
 protected:
-    void onTabInserted();
-    void onTabRemoved();
+    void onTabInserted(int index);
+    void onTabRemoved(int index);
+    ///@brief Called when the user re-orders tabs
+    void onTabMoved(int from, int to);
     void onCurrentTabChanged(int index);
     bool onMouseDoubleClick(QPoint localPos);
 
@@ -187,6 +187,9 @@ void TitleBar::setTitle(const QString &title)
 
 void TitleBar::setIcon(const QIcon &icon)
 {
+    if (icon.cacheKey() == m_icon.cacheKey())
+        return;
+
     m_icon = icon;
     Q_EMIT iconChanged();
 }
@@ -222,7 +225,7 @@ std::unique_ptr<WindowBeingDragged> TitleBar::makeWindow()
     QRect r = m_frame->QWidgetAdapter::geometry();
     r.moveTopLeft(m_frame->mapToGlobal(QPoint(0, 0)));
 
-    auto floatingWindow = Config::self().frameworkWidgetFactory()->createFloatingWindow(m_frame);
+    auto floatingWindow = Config::self().frameworkWidgetFactory()->acquireFloatingWindow(m_frame);
     floatingWindow->setSuggestedGeometry(r, SuggestedGeometryHint_GeometryIsFromDocked);
     floatingWindow->show();
 
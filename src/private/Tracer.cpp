@@ -0,0 +1,123 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2021 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "Tracer_p.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QThread>
+#include <QVector>
+#include <QDebug>
+
+using namespace KDDockWidgets;
+using namespace KDDockWidgets::Debug;
+
+/// @brief Stop recording past this many spans, so a forgotten trace doesn't eat all memory
+static const int s_maxSpans = 1 << 20;
+
+namespace {
+struct Span
+{
+    const char *name;
+    qint64 start;
+    qint64 duration;
+};
+
+struct TracerData
+{
+    QString filename;
+    QElapsedTimer clock;
+    QVector<Span> spans;
+};
+}
+
+static TracerData &tracerData()
+{
+    static TracerData s_data;
+    return s_data;
+}
+
+bool Tracer::s_enabled = false;
+
+void Tracer::start(const QString &filename)
+{
+    TracerData &data = tracerData();
+    data.filename = filename;
+    data.spans.clear();
+    data.clock.start();
+    s_enabled = true;
+}
+
+bool Tracer::stop()
+{
+    if (!s_enabled)
+        return true;
+
+    s_enabled = false;
+    TracerData &data = tracerData();
+
+    QFile file(data.filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << Q_FUNC_INFO << "Failed to open" << data.filename << file.errorString();
+        return false;
+    }
+
+    // Written by hand instead of with QJsonDocument, traces can have a million spans.
+    // Timestamps are in microseconds, as the format wants.
+    file.write("{\"traceEvents\":[\n");
+    for (int i = 0, count = data.spans.size(); i < count; ++i) {
+        const Span &span = data.spans.at(i);
+        QByteArray line = "{\"name\":\"" + QByteArray(span.name)
+            + "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" + QByteArray::number(span.start / 1000.0, 'f', 3)
+            + ",\"dur\":" + QByteArray::number(span.duration / 1000.0, 'f', 3) + "}";
+        if (i != count - 1)
+            line += ',';
+        line += '\n';
+        file.write(line);
+    }
+    file.write("],\"displayTimeUnit\":\"ms\"}\n");
+
+    data.spans.clear();
+    data.spans.squeeze();
+
+    return true;
+}
+
+qint64 Tracer::now()
+{
+    return tracerData().clock.nsecsElapsed();
+}
+
+void Tracer::addSpan(const char *name, qint64 startNs, qint64 durationNs)
+{
+    if (!s_enabled)
+        return;
+
+    // The spans aren't protected by a mutex, so other threads are ignored
+    QCoreApplication *app = QCoreApplication::instance();
+    if (!app || QThread::currentThread() != app->thread())
+        return;
+
+    TracerData &data = tracerData();
+    if (data.spans.size() >= s_maxSpans) {
+        qWarning() << Q_FUNC_INFO << "Too many spans, stopping the trace";
+        stop();
+        return;
+    }
+
+    data.spans.push_back({ name, startNs, durationNs });
+}
+
+int Tracer::dbg_numSpans()
+{
+    return tracerData().spans.size();
+}
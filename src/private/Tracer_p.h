@@ -0,0 +1,93 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2021 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+/**
+ * @file
+ * @brief Records how long internal operations take, as Chrome trace JSON.
+ *
+ * @author Sérgio Martins \<sergio.martins@kdab.com\>
+ */
+
+#ifndef KD_TRACER_P_H
+#define KD_TRACER_P_H
+
+#include "kddockwidgets/docks_export.h"
+
+#include <QString>
+
+namespace KDDockWidgets {
+namespace Debug {
+
+/**
+ * @brief Collects spans of the hot operations (layouting, restore, dragging) and writes them as
+ * Chrome trace JSON, which can be opened in Perfetto or chrome://tracing.
+ *
+ * Enabled with KDDOCKWIDGETS_TRACE_FILE=<file.json>. The file is written when the application quits.
+ * When disabled, a span costs a single bool check.
+ *
+ * Only the GUI thread is traced, spans from other threads are dropped. Span names must be string literals, as they're stored by pointer.
+ */
+class DOCKS_EXPORT_FOR_UNIT_TESTS Tracer
+{
+public:
+    ///@brief Returns whether spans are being recorded
+    static bool isEnabled()
+    {
+        return s_enabled;
+    }
+
+    ///@brief Starts recording. Any previous recording is discarded.
+    static void start(const QString &filename);
+
+    ///@brief Stops recording and writes the trace. Returns false on error.
+    static bool stop();
+
+    ///@brief Returns the current time, in nanoseconds since start()
+    static qint64 now();
+
+    ///@brief Records a span that started at @p startNs and lasted @p durationNs
+    static void addSpan(const char *name, qint64 startNs, qint64 durationNs);
+
+    ///@brief Returns the number of spans recorded so far. For tests.
+    static int dbg_numSpans();
+
+private:
+    static bool s_enabled;
+};
+
+/**
+ * @brief RAII helper which records a span for its scope.
+ */
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char *name)
+        : m_name(Tracer::isEnabled() ? name : nullptr)
+        , m_start(m_name ? Tracer::now() : 0)
+    {
+    }
+
+    ~TraceSpan()
+    {
+        if (m_name)
+            Tracer::addSpan(m_name, m_start, Tracer::now() - m_start);
+    }
+
+private:
+    Q_DISABLE_COPY(TraceSpan)
+    const char *const m_name;
+    const qint64 m_start;
+};
+
+}
+}
+
+#endif
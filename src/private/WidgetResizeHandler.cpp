@@ -417,7 +417,8 @@ void WidgetResizeHandler::setTarget(QWidgetOrQuick *w)
         if (m_isTopLevelWindowResizer) {
             mTarget->installEventFilter(this);
         } else {
-            qApp->installEventFilter(this);
+            // Gets the application's mouse events through DockRegistry's event filter
+            DockRegistry::self()->registerResizeHandler(this);
         }
     } else {
         qWarning() << "Target widget is null!";
@@ -135,6 +135,7 @@ protected:
     bool eventFilter(QObject *o, QEvent *e) override;
 
 private:
+    friend class DockRegistry;
     void setTarget(QWidgetOrQuick *w);
     bool mouseMoveEvent(QMouseEvent *e);
     void updateCursor(CursorPosition m);
@@ -10,6 +10,7 @@
 */
 
 #include "WindowBeingDragged_p.h"
+#include "DockRegistry_p.h"
 #include "DragController_p.h"
 #include "Frame_p.h"
 #include "LayoutWidget_p.h"
@@ -129,6 +130,12 @@ QStringList WindowBeingDragged::affinities() const
                             : QStringList();
 }
 
+AffinityMask WindowBeingDragged::affinityMask() const
+{
+    return m_floatingWindow ? m_floatingWindow->affinityMask()
+                            : AffinityMask();
+}
+
 QSize WindowBeingDragged::size() const
 {
     if (m_floatingWindow)
@@ -250,6 +257,18 @@ QStringList WindowBeingDraggedWayland::affinities() const
     return {};
 }
 
+AffinityMask WindowBeingDraggedWayland::affinityMask() const
+{
+    if (m_floatingWindow)
+        return WindowBeingDragged::affinityMask();
+    else if (m_frame)
+        return m_frame->affinityMask();
+    else if (m_dockWidget)
+        return AffinityMask(m_dockWidget->affinities());
+
+    return {};
+}
+
 QVector<DockWidgetBase *> WindowBeingDraggedWayland::dockWidgets() const
 {
     if (m_floatingWindow)
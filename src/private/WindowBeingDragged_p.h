@@ -52,6 +52,9 @@ public:
     ///@brief returns the affinities of the window being dragged
     virtual QStringList affinities() const;
 
+    ///@brief Same as affinities(), but interned. Cheaper to match.
+    virtual AffinityMask affinityMask() const;
+
     ///@brief size of the window being dragged contents
     virtual QSize size() const;
 
@@ -88,6 +91,7 @@ public:
     QSize maxSize() const override;
     QPixmap pixmap() const override;
     QStringList affinities() const override;
+    AffinityMask affinityMask() const override;
     QVector<DockWidgetBase*> dockWidgets() const override;
 
     // These two are set for Wayland only, where we can't make the floating window immediately (no way to position it)
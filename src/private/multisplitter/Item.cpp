@@ -14,13 +14,19 @@
 #include "MultiSplitterConfig.h"
 #include "Widget.h"
 #include "ItemFreeContainer_p.h"
+#include "Tracer_p.h"
 
 #include <QEvent>
 #include <QDebug>
+#include <QPointer>
 #include <QScopedValueRollback>
 #include <QTimer>
 #include <QGuiApplication>
 #include <QScreen>
+#include <QSet>
+#include <QHash>
+
+#include <algorithm>
 
 #ifdef Q_CC_MSVC
 # pragma warning(push)
@@ -42,6 +48,7 @@ QSize Layouting::Item::hardcodedMinimumSize = QSize(80, 90);
 QSize Layouting::Item::hardcodedMaximumSize = QSize(16777215, 16777215);
 
 bool Layouting::ItemBoxContainer::s_inhibitSimplify = false;
+quint64 Layouting::ItemBoxContainer::s_numRelayouts = 0;
 
 inline bool locationIsVertical(Location loc)
 {
@@ -85,6 +92,17 @@ inline QRect adjustedRect(QRect r, Qt::Orientation o, int p1, int p2)
     return r;
 }
 
+/// @brief Lets the root container know that the guests it holds, or their order, changed
+/// Unlike Item::root(), this also works for ItemFreeContainer roots
+inline void emitGuestsChanged(Layouting::Item *item)
+{
+    while (Layouting::ItemContainer *parent = item->parentContainer())
+        item = parent;
+
+    if (Layouting::ItemContainer *root = item->asContainer())
+        Q_EMIT root->guestsChanged();
+}
+
 namespace Layouting {
 struct LengthOnSide
 {
@@ -208,6 +226,7 @@ void Item::setGuestWidget(Widget *guest)
     }
 
     updateObjectName();
+    emitGuestsChanged(this);
 }
 
 void Item::updateWidgetGeometries()
@@ -235,6 +254,7 @@ void Item::fillFromVariantMap(const QVariantMap &map, const QHash<QString, Widge
 {
     m_sizingInfo.fromVariantMap(map[QStringLiteral("sizingInfo")].toMap());
     m_isVisible = map[QStringLiteral("isVisible")].toBool();
+    invalidateSizeCache_recursive();
     setObjectName(map[QStringLiteral("objectName")].toString());
 
     const QString guestId = map.value(QStringLiteral("guestId")).toString();
@@ -366,6 +386,7 @@ bool Item::isBeingInserted() const
 void Item::setBeingInserted(bool is)
 {
     m_sizingInfo.isBeingInserted = is;
+    invalidateSizeCache_recursive();
 
     // Trickle up the hierarchy too, as the parent might be hidden due to not having visible children
     if (auto parent = parentContainer()) {
@@ -378,6 +399,17 @@ void Item::setBeingInserted(bool is)
     }
 }
 
+void Item::invalidateSizeCache_recursive()
+{
+    for (Item *item = this; item; item = item->m_parent) {
+        if (ItemContainer *container = item->asContainer()) {
+            container->invalidateVisibleChildrenCache();
+            if (ItemBoxContainer *boxContainer = container->asBoxContainer())
+                boxContainer->invalidateSizeCache();
+        }
+    }
+}
+
 void Item::setParentContainer(ItemContainer *parent)
 {
     if (parent == m_parent)
@@ -386,6 +418,7 @@ void Item::setParentContainer(ItemContainer *parent)
     if (m_parent) {
         disconnect(this, &Item::minSizeChanged, m_parent, &ItemContainer::onChildMinSizeChanged);
         disconnect(this, &Item::visibleChanged, m_parent, &ItemContainer::onChildVisibleChanged);
+        invalidateSizeCache_recursive();
         Q_EMIT visibleChanged(this, false);
     }
 
@@ -399,6 +432,7 @@ void Item::setParentContainer(ItemContainer *parent)
     }
 
     m_parent = parent;
+    invalidateSizeCache_recursive();
     connectParent(parent); // Reused by the ctor too
 
     QObject::setParent(parent);
@@ -446,6 +480,7 @@ void Item::setMinSize(QSize sz)
 {
     if (sz != m_sizingInfo.minSize) {
         m_sizingInfo.minSize = sz;
+        invalidateSizeCache_recursive();
         Q_EMIT minSizeChanged(this);
         if (!m_isSettingGuest)
             setSize_recursive(size().expandedTo(sz));
@@ -456,6 +491,7 @@ void Item::setMaxSizeHint(QSize sz)
 {
     if (sz != m_sizingInfo.maxSizeHint) {
         m_sizingInfo.maxSizeHint = sz;
+        invalidateSizeCache_recursive();
         Q_EMIT maxSizeChanged(this);
     }
 }
@@ -586,6 +622,11 @@ bool Item::isPlaceholder() const
     return !isVisible();
 }
 
+qint64 Item::placeholderAge() const
+{
+    return isPlaceholder() ? m_sinceVisibilityChanged.elapsed() : 0;
+}
+
 bool Item::isVisible(bool excludeBeingInserted) const
 {
     return m_isVisible && !(excludeBeingInserted && isBeingInserted());
@@ -595,6 +636,8 @@ void Item::setIsVisible(bool is)
 {
     if (is != m_isVisible) {
         m_isVisible = is;
+        m_sinceVisibilityChanged.start();
+        invalidateSizeCache_recursive();
         Q_EMIT visibleChanged(this, is);
     }
 
@@ -745,6 +788,7 @@ Item::Item(Widget *hostWidget, ItemContainer *parent)
     , m_parent(parent)
     , m_hostWidget(hostWidget)
 {
+    m_sinceVisibilityChanged.start();
     connectParent(parent);
 }
 
@@ -754,6 +798,7 @@ Item::Item(bool isContainer, Widget *hostWidget, ItemContainer *parent)
     , m_parent(parent)
     , m_hostWidget(hostWidget)
 {
+    m_sinceVisibilityChanged.start();
     connectParent(parent);
 }
 
@@ -806,6 +851,7 @@ void Item::updateObjectName()
 void Item::onWidgetDestroyed()
 {
     m_guest = nullptr;
+    emitGuestsChanged(this);
 
     if (m_refCount) {
         turnIntoPlaceholder();
@@ -814,6 +860,17 @@ void Item::onWidgetDestroyed()
     }
 }
 
+void Item::releaseGuest()
+{
+    QObject *guest = guestAsQObject();
+    if (!guest)
+        return;
+
+    guest->removeEventFilter(this);
+    disconnect(guest, nullptr, this, nullptr);
+    onWidgetDestroyed();
+}
+
 void Item::onWidgetLayoutRequested()
 {
     if (Widget *w = guestWidget()) {
@@ -825,8 +882,22 @@ void Item::onWidgetLayoutRequested()
                        << m_sizingInfo.isBeingInserted;
         }
 
+        if (Config::self().flags() & Config::Flag::CoalescedSizeConstraints) {
+            if (ItemBoxContainer *root = this->root()) {
+                root->schedulePendingGuestConstraints(this);
+                return;
+            }
+        }
+
+        applyGuestConstraints();
+    }
+}
+
+void Item::applyGuestConstraints()
+{
+    if (Widget *w = guestWidget()) {
         if (w->minSize() != minSize()) {
-            setMinSize(m_guest->minSize());
+            setMinSize(w->minSize());
         }
 
         setMaxSizeHint(w->maxSizeHint());
@@ -946,6 +1017,7 @@ struct ItemBoxContainer::Private
     void updateSeparators_recursive();
     QSize minSize(const Item::List &items) const;
     int excessLength() const;
+    void honourChildMinSize(Item *child);
 
     mutable bool m_checkSanityScheduled = false;
     QVector<Layouting::Separator*> m_separators;
@@ -954,6 +1026,17 @@ struct ItemBoxContainer::Private
     bool m_isDeserializing = false;
     bool m_isSimplifying = false;
     Qt::Orientation m_orientation = Qt::Vertical;
+    // Invalid QSize means not calculated yet. See invalidateSizeCache()
+    mutable QSize m_cachedMinSize;
+    mutable QSize m_cachedMaxSizeHint;
+
+    // Only used with Flag::CoalescedSizeConstraints, and only by the root container.
+    // See applyPendingGuestConstraints()
+    QVector<QPointer<Item>> m_itemsWithPendingConstraints;
+    QSet<const Item *> m_itemsWithPendingConstraintsSet; // For de-duplicating the above
+    QVector<QPair<ItemBoxContainer *, Item *>> m_childrenWithNewMinSize;
+    bool m_collectingMinSizeChanges = false;
+
     ItemBoxContainer *const q;
 };
 
@@ -1193,6 +1276,7 @@ void ItemBoxContainer::restore(Item *child)
 
 void ItemBoxContainer::removeItem(Item *item, bool hardRemove)
 {
+    Debug::TraceSpan span("removeItem");
     Q_ASSERT(!item->isRoot());
 
     if (!contains(item)) {
@@ -1209,7 +1293,9 @@ void ItemBoxContainer::removeItem(Item *item, bool hardRemove)
 
     if (hardRemove) {
         m_children.removeOne(item);
+        invalidateSizeCache_recursive();
         delete item;
+        emitGuestsChanged(this);
         if (!isContainer)
             Q_EMIT root()->numItemsChanged();
     } else {
@@ -1265,6 +1351,7 @@ ItemBoxContainer *ItemBoxContainer::convertChildToContainer(Item *leaf)
 
     insertItem(container, index, DefaultSizeMode::NoDefaultSizeMode);
     m_children.removeOne(leaf);
+    invalidateSizeCache_recursive();
     container->setGeometry(leaf->geometry());
     container->insertItem(leaf, Location_OnTop, DefaultSizeMode::NoDefaultSizeMode);
     Q_EMIT itemsChanged();
@@ -1333,6 +1420,7 @@ void ItemBoxContainer::insertItem(Item *item, Location loc,
         if (m_children.size() == 1) {
             // 2 items is the minimum to know which orientation we're layedout
             d->m_orientation = locOrientation;
+            invalidateSizeCache_recursive();
         }
 
         const auto index = locationIsSide1(loc) ? 0 : m_children.size();
@@ -1344,6 +1432,7 @@ void ItemBoxContainer::insertItem(Item *item, Location loc,
         container->setGeometry(rect());
         container->setChildren(m_children, d->m_orientation);
         m_children.clear();
+        invalidateSizeCache_recursive();
         setOrientation(oppositeOrientation(d->m_orientation));
         insertItem(container, 0, DefaultSizeMode::NoDefaultSizeMode);
 
@@ -1365,25 +1454,121 @@ void ItemBoxContainer::onChildMinSizeChanged(Item *child)
         return;
     }
 
+    ItemBoxContainer *root = this->root();
+    if (root && root->d->m_collectingMinSizeChanges) {
+        // Resolved for all children at once, by applyPendingGuestConstraints()
+        root->d->m_childrenWithNewMinSize.push_back({ this, child });
+        return;
+    }
+
     updateSizeConstraints();
+    d->honourChildMinSize(child);
+}
 
+void ItemBoxContainer::Private::honourChildMinSize(Item *child)
+{
     if (child->isBeingInserted())
         return;
 
-    if (numVisibleChildren() == 1 && child->isVisible()) {
+    if (q->numVisibleChildren() == 1 && child->isVisible()) {
         // The easy case. Child is alone in the layout, occupies everything.
-        child->setGeometry(rect());
-        updateChildPercentages();
+        child->setGeometry(q->rect());
+        q->updateChildPercentages();
         return;
     }
 
     const QSize missingForChild = child->missingSize();
     if (!missingForChild.isNull()) {
         // Child has some growing to do. It will grow left and right equally, (and top-bottom), as needed.
-        growItem(child, Layouting::length(missingForChild, d->m_orientation), GrowthStrategy::BothSidesEqually, NeighbourSqueezeStrategy::AllNeighbours);
+        q->growItem(child, Layouting::length(missingForChild, m_orientation), GrowthStrategy::BothSidesEqually, NeighbourSqueezeStrategy::AllNeighbours);
     }
 
-    updateChildPercentages();
+    q->updateChildPercentages();
+}
+
+void ItemBoxContainer::schedulePendingGuestConstraints(Item *item)
+{
+    if (d->m_itemsWithPendingConstraintsSet.contains(item))
+        return;
+
+    if (d->m_itemsWithPendingConstraints.isEmpty()) {
+        QTimer::singleShot(0, this, [this] {
+            applyPendingGuestConstraints();
+        });
+    }
+
+    d->m_itemsWithPendingConstraints.push_back(item);
+    d->m_itemsWithPendingConstraintsSet.insert(item);
+}
+
+void ItemBoxContainer::applyPendingGuestConstraints()
+{
+    Debug::TraceSpan span("applyPendingGuestConstraints");
+
+    const QVector<QPointer<Item>> items = d->m_itemsWithPendingConstraints;
+    d->m_itemsWithPendingConstraints.clear();
+    d->m_itemsWithPendingConstraintsSet.clear();
+
+    {
+        // Bottom-up: Apply the new constraints to the leaves. The min sizes of the containers above
+        // them are recalculated lazily, so here we only remember which children need more room.
+        QScopedValueRollback<bool> collecting(d->m_collectingMinSizeChanges, true);
+        for (Item *item : items) {
+            if (!item)
+                continue;
+
+            // Don't let the item grow over its neighbours, its container makes room for it below
+            QScopedValueRollback<bool> guard(item->m_isSettingGuest, item->root() == this);
+            item->applyGuestConstraints();
+        }
+    }
+
+    QVector<QPair<ItemBoxContainer *, Item *>> changes = d->m_childrenWithNewMinSize;
+    d->m_childrenWithNewMinSize.clear();
+    if (changes.isEmpty())
+        return;
+
+    // Every ancestor of a child which needs more room might need more room too
+    QSet<QPair<ItemBoxContainer *, Item *>> queued;
+    queued.reserve(changes.size());
+    for (const auto &change : qAsConst(changes))
+        queued.insert(change);
+
+    for (int i = 0; i < changes.size(); ++i) {
+        ItemBoxContainer *container = changes.at(i).first;
+        if (ItemBoxContainer *parent = container->parentBoxContainer()) {
+            const QPair<ItemBoxContainer *, Item *> change = { parent, container };
+            if (!queued.contains(change)) {
+                queued.insert(change);
+                changes.push_back(change);
+            }
+        }
+    }
+
+    // Each container's depth is needed by several comparisons, so calculate it once
+    QHash<const ItemBoxContainer *, int> depths;
+    depths.reserve(changes.size());
+    for (const auto &change : qAsConst(changes)) {
+        if (depths.contains(change.first))
+            continue;
+
+        int depth = 0;
+        for (const Item *p = change.first->parentContainer(); p; p = p->parentContainer())
+            depth++;
+        depths.insert(change.first, depth);
+    }
+
+    std::stable_sort(changes.begin(), changes.end(), [&depths] (const QPair<ItemBoxContainer *, Item *> &a,
+                                                                const QPair<ItemBoxContainer *, Item *> &b) {
+        return depths.value(a.first) < depths.value(b.first);
+    });
+
+    // Top-down: Grow the whole layout if needed, then each container makes room for its children
+    updateSizeConstraints();
+    for (const auto &change : qAsConst(changes)) {
+        if (change.second->isVisible() && change.second->parentContainer() == change.first)
+            change.first->d->honourChildMinSize(change.second);
+    }
 }
 
 void ItemBoxContainer::updateSizeConstraints()
@@ -1553,6 +1738,7 @@ QRect ItemBoxContainer::suggestedDropRectFallback(const Item *item, const Item *
 
 void ItemBoxContainer::positionItems()
 {
+    s_numRelayouts++;
     SizingInfo::List sizes = this->sizes();
     positionItems(/*by-ref=*/sizes);
     applyPositions(sizes);
@@ -1560,6 +1746,11 @@ void ItemBoxContainer::positionItems()
     d->updateSeparators_recursive();
 }
 
+quint64 ItemBoxContainer::dbg_numRelayouts()
+{
+    return s_numRelayouts;
+}
+
 void ItemBoxContainer::positionItems_recursive()
 {
     positionItems();
@@ -1627,6 +1818,8 @@ void ItemBoxContainer::clear()
         delete item;
     }
     m_children.clear();
+    invalidateSizeCache_recursive();
+    emitGuestsChanged(this);
     d->deleteSeparators();
 }
 
@@ -1688,6 +1881,7 @@ void ItemBoxContainer::setLength_recursive(int length, Qt::Orientation o)
 
 void ItemBoxContainer::insertItem(Item *item, int index, InitialOption option)
 {
+    Debug::TraceSpan span("insertItem");
     if (option.sizeMode != DefaultSizeMode::NoDefaultSizeMode) {
         /// Choose a nice size for the item we're adding
         const int suggestedLength = d->defaultLengthFor(item, option);
@@ -1696,6 +1890,8 @@ void ItemBoxContainer::insertItem(Item *item, int index, InitialOption option)
 
     m_children.insert(index, item);
     item->setParentContainer(this);
+    invalidateSizeCache_recursive();
+    emitGuestsChanged(this);
 
     Q_EMIT itemsChanged();
 
@@ -1737,6 +1933,7 @@ void ItemBoxContainer::setChildren(const List &children, Qt::Orientation o)
     m_children = children;
     for (Item *item : children)
         item->setParentContainer(this);
+    invalidateSizeCache_recursive();
 
     setOrientation(o);
 }
@@ -1745,6 +1942,7 @@ void ItemBoxContainer::setOrientation(Qt::Orientation o)
 {
     if (o != d->m_orientation) {
         d->m_orientation = o;
+        invalidateSizeCache_recursive();
         d->updateSeparators_recursive();
     }
 }
@@ -1780,11 +1978,17 @@ QSize ItemBoxContainer::Private::minSize(const Item::List &items) const
 
 QSize ItemBoxContainer::minSize() const
 {
-    return d->minSize(m_children);
+    if (!d->m_cachedMinSize.isValid())
+        d->m_cachedMinSize = d->minSize(m_children);
+
+    return d->m_cachedMinSize;
 }
 
 QSize ItemBoxContainer::maxSizeHint() const
 {
+    if (d->m_cachedMaxSizeHint.isValid())
+        return d->m_cachedMaxSizeHint;
+
     int maxW = isVertical() ? hardcodedMaximumSize.width() : 0;
     int maxH = isVertical() ? 0 : hardcodedMaximumSize.height();
 
@@ -1819,7 +2023,17 @@ QSize ItemBoxContainer::maxSizeHint() const
     if (maxH == 0)
         maxH = hardcodedMaximumSize.height();
 
-    return QSize(maxW, maxH).expandedTo(d->minSize(visibleChildren));
+    d->m_cachedMaxSizeHint = QSize(maxW, maxH).expandedTo(d->minSize(visibleChildren));
+    return d->m_cachedMaxSizeHint;
+}
+
+void ItemBoxContainer::invalidateSizeCache()
+{
+    d->m_cachedMinSize = QSize();
+    d->m_cachedMaxSizeHint = QSize();
+
+    // Constraints changed, the range of a separator being dragged might have changed too
+    Separator::invalidateDragBounds();
 }
 
 void ItemBoxContainer::Private::resizeChildren(QSize oldSize, QSize newSize, SizingInfo::List &childSizes,
@@ -2003,6 +2217,7 @@ void ItemBoxContainer::Private::honourMaxSizes(SizingInfo::List &sizes)
 
 void ItemBoxContainer::setSize_recursive(QSize newSize, ChildrenResizeStrategy strategy)
 {
+    Debug::TraceSpan span("setSize_recursive");
     QScopedValueRollback<bool> block(d->m_blockUpdatePercentages, true);
 
     const QSize minSize = this->minSize();
@@ -2017,6 +2232,11 @@ void ItemBoxContainer::setSize_recursive(QSize newSize, ChildrenResizeStrategy s
     if (newSize == size())
         return;
 
+    if (isRoot()) {
+        // The whole layout resized, the range of a separator being dragged changed
+        Separator::invalidateDragBounds();
+    }
+
     const QSize oldSize = size();
     setSize(newSize);
 
@@ -2213,6 +2433,7 @@ int ItemBoxContainer::oppositeLength() const
 
 void ItemBoxContainer::requestSeparatorMove(Separator *separator, int delta)
 {
+    Debug::TraceSpan span("requestSeparatorMove");
     const auto separatorIndex = d->m_separators.indexOf(separator);
     if (separatorIndex == -1) {
         // Doesn't happen
@@ -2224,9 +2445,9 @@ void ItemBoxContainer::requestSeparatorMove(Separator *separator, int delta)
     if (delta == 0)
         return;
 
-    const int min = minPosForSeparator_global(separator);
+    const int min = separator->minPositionForDrag();
     const int pos = separator->position();
-    const int max = maxPosForSeparator_global(separator);
+    const int max = separator->maxPositionForDrag();
 
     if ((pos + delta < min && delta < 0) || // pos can be smaller than min, as long as we're making the distane to minPos smaller, same for max.
         (pos + delta > max && delta > 0)) { // pos can be bigger than max already and going left/up (negative delta, which is fine), just don't increase if further
@@ -3121,6 +3342,7 @@ void ItemBoxContainer::simplify()
 
     if (m_children != newChildren) {
         m_children = newChildren;
+        invalidateSizeCache_recursive();
         positionItems();
         updateChildPercentages();
     }
@@ -3247,6 +3469,9 @@ void ItemBoxContainer::fillFromVariantMap(const QVariantMap &map,
         m_children.push_back(child);
     }
 
+    invalidateSizeCache_recursive();
+    emitGuestsChanged(this);
+
     if (isRoot()) {
         updateChildPercentages_recursive();
         if (hostWidget()) {
@@ -3531,7 +3756,34 @@ struct ItemContainer::Private
     ~Private()
     {
     }
+
+    void ensureVisibleChildrenCache() const
+    {
+        if (m_visibleChildrenCacheValid)
+            return;
+
+        m_cachedVisibleChildren.clear();
+        m_cachedVisibleChildren.reserve(q->m_children.size());
+        m_cachedNumVisibleChildren = 0;
+        for (Item *item : qAsConst(q->m_children)) {
+            if (item->isVisible()) {
+                m_cachedNumVisibleChildren++;
+                if (!item->isBeingInserted())
+                    m_cachedVisibleChildren << item;
+            }
+        }
+
+        m_visibleChildrenCacheValid = true;
+    }
+
     ItemContainer *const q;
+
+    // visibleChildren() and numVisibleChildren() are called on every layouting pass and most
+    // children might be placeholders, so don't filter them each time.
+    // Cleared by invalidateVisibleChildrenCache(), which invalidateSizeCache_recursive() reaches.
+    mutable Item::List m_cachedVisibleChildren;
+    mutable int m_cachedNumVisibleChildren = 0;
+    mutable bool m_visibleChildrenCacheValid = false;
 };
 
 ItemContainer::ItemContainer(Widget *hostWidget, ItemContainer *parent)
@@ -3589,12 +3841,13 @@ int ItemContainer::numChildren() const
 
 int ItemContainer::numVisibleChildren() const
 {
-    int num = 0;
-    for (Item *child : qAsConst(m_children)) {
-        if (child->isVisible())
-            num++;
-    }
-    return num;
+    d->ensureVisibleChildrenCache();
+    return d->m_cachedNumVisibleChildren;
+}
+
+void ItemContainer::invalidateVisibleChildrenCache()
+{
+    d->m_visibleChildrenCacheValid = false;
 }
 
 bool ItemContainer::isEmpty() const
@@ -3643,6 +3896,11 @@ Item *ItemContainer::itemForWidget(const Widget *w) const
 
 Item::List ItemContainer::visibleChildren(bool includeBeingInserted) const
 {
+    if (!includeBeingInserted) {
+        d->ensureVisibleChildrenCache();
+        return d->m_cachedVisibleChildren;
+    }
+
     Item::List items;
     items.reserve(m_children.size());
     for (Item *item : qAsConst(m_children)) {
@@ -41,6 +41,7 @@ void ItemFreeContainer::addDockWidget(Item *item, QPoint localPt)
     item->setPos(localPt);
 
     Q_EMIT itemsChanged();
+    Q_EMIT guestsChanged();
 
     if (item->isVisible())
         Q_EMIT numVisibleItemsChanged(numVisibleChildren());
@@ -52,6 +53,8 @@ void ItemFreeContainer::clear()
 {
     qDeleteAll(m_children);
     m_children.clear();
+    invalidateSizeCache_recursive();
+    Q_EMIT guestsChanged();
 }
 
 void ItemFreeContainer::removeItem(Item *item, bool hardRemove)
@@ -60,7 +63,9 @@ void ItemFreeContainer::removeItem(Item *item, bool hardRemove)
 
     if (hardRemove) {
         m_children.removeOne(item);
+        invalidateSizeCache_recursive();
         delete item;
+        Q_EMIT guestsChanged();
     } else {
         item->setIsVisible(false);
         item->setGuestWidget(nullptr);
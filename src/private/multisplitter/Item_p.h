@@ -14,6 +14,7 @@
 #include "kddockwidgets/docks_export.h"
 #include "kddockwidgets/KDDockWidgets.h"
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QVector>
 #include <QRect>
@@ -267,6 +268,9 @@ public:
     void setMinSize(QSize);
     void setMaxSizeHint(QSize);
     bool isPlaceholder() const;
+
+    ///@brief Returns for how long, in ms, this item has been a placeholder. 0 if it's visible.
+    qint64 placeholderAge() const;
     void setGeometry(QRect rect);
     ItemBoxContainer *root() const;
     QRect mapToRoot(QRect) const;
@@ -281,6 +285,10 @@ public:
     Widget *guestWidget() const { return m_guest; }
     void setGuestWidget(Widget *);
 
+    ///@brief Forgets the guest widget, same as if it had been deleted.
+    /// Used when the guest is recycled instead of deleted. See FrameworkWidgetFactory::setFramePoolSize()
+    void releaseGuest();
+
     void ref();
     void unref();
     int refCount() const;
@@ -340,6 +348,10 @@ protected:
     bool isBeingInserted() const;
     void setBeingInserted(bool);
 
+    ///@brief Invalidates the cached min/max sizes of this item and of all its ancestors.
+    /// Called whenever something they're calculated from changes.
+    void invalidateSizeCache_recursive();
+
     SizingInfo m_sizingInfo;
     const bool m_isContainer;
     ItemContainer *m_parent = nullptr;
@@ -348,6 +360,8 @@ private Q_SLOTS:
     void onWidgetLayoutRequested();
 
 private:
+    ///@brief Sets our min and max sizes from the guest's
+    void applyGuestConstraints();
     friend class ItemContainer;
     friend class ItemBoxContainer;
     friend class ItemFreeContainer;
@@ -357,6 +371,7 @@ private:
     void updateObjectName();
     void onWidgetDestroyed();
     bool m_isVisible = false;
+    QElapsedTimer m_sinceVisibilityChanged;
     Widget *m_hostWidget = nullptr;
     Widget *m_guest = nullptr;
 };
@@ -394,6 +409,10 @@ public:
 protected:
     bool hasSingleVisibleItem() const;
 
+    ///@brief Drops the cached visibleChildren(). Called by invalidateSizeCache_recursive(), which
+    /// runs whenever m_children or the visibility of a child changes.
+    void invalidateVisibleChildrenCache();
+
     Item::List m_children;
 
 Q_SIGNALS:
@@ -401,7 +420,11 @@ Q_SIGNALS:
     void numVisibleItemsChanged(int);
     void numItemsChanged();
 
+    ///@brief Emitted by the root container when a guest is added or removed anywhere in the tree
+    void guestsChanged();
+
 private:
+    friend class Item;
     struct Private;
     Private *const d;
 };
@@ -524,6 +547,16 @@ private:
 
     int indexOf(Separator *) const;
     bool isInSimplify() const;
+    void invalidateSizeCache();
+
+    ///@brief Queues @p item to have its guest's min/max sizes applied on the next event loop
+    /// iteration, together with all the others. Only called on the root container, with
+    /// Flag::CoalescedSizeConstraints.
+    void schedulePendingGuestConstraints(Item *item);
+
+    ///@brief Applies the queued constraints in a single pass. Instead of each new min-size
+    /// relayouting all its ancestors, every container is visited once, from the root down.
+    void applyPendingGuestConstraints();
 
 #ifdef DOCKS_DEVELOPER_MODE
     bool test_suggestedRect();
@@ -532,9 +565,14 @@ private:
 public:
     QVector<Layouting::Separator*> separators_recursive() const;
     QVector<Layouting::Separator*> separators() const;
+
+    ///@brief Returns how many times containers positioned their children, process-wide.
+    ///Used by the DebugWindow to show relayouts per second
+    static quint64 dbg_numRelayouts();
 private:
     void simplify();
     static bool s_inhibitSimplify;
+    static quint64 s_numRelayouts;
     friend class Layouting::Item;
     friend class ::TestMultiSplitter;
     struct Private;
@@ -27,7 +27,9 @@ public:
 
     enum class Flag {
         None = 0,
-        LazyResize = 1
+        LazyResize = 1,
+        CoalescedResize = 2,
+        CoalescedSizeConstraints = 4
     };
     Q_DECLARE_FLAGS(Flags, Flag);
 
@@ -15,7 +15,9 @@
 #include "Item_p.h"
 #include "MultiSplitterConfig.h"
 
+#include <QElapsedTimer>
 #include <QGuiApplication>
+#include <QTimer>
 
 #ifdef Q_OS_WIN
 # include <windows.h>
@@ -28,6 +30,9 @@ Separator* Separator::s_separatorBeingDragged = nullptr;
 /// @brief internal counter just for unit-tests
 static int s_numSeparators = 0;
 
+/// @brief With Flag::CoalescedResize, separator moves are applied at most once per this interval
+static const int s_frameBudgetMs = 16;
+
 struct Separator::Private
 {
     // Only set when anchor is moved through mouse. Side1 if going towards left or top, Side2 otherwise.
@@ -43,13 +48,44 @@ struct Separator::Private
     ItemBoxContainer *parentContainer = nullptr;
     Layouting::Side lastMoveDirection = Side1;
     const bool usesLazyResize = Config::self().flags() & Config::Flag::LazyResize;
+    const bool usesCoalescedResize = !usesLazyResize && (Config::self().flags() & Config::Flag::CoalescedResize);
     Widget *const m_hostWidget;
+
+    // Only used with Flag::CoalescedResize.
+    // The latest position the mouse asked for, applied when coalescedMoveTimer fires
+    int pendingPosition = -1;
+    QTimer coalescedMoveTimer;
+    QElapsedTimer sinceLastMove; // Started when the last move started
+    qint64 lastMoveCostMs = 0; // Includes the repaint that follows the move, see applyPendingMove()
+    QTimer repaintDoneTimer;
+
+    // The allowed range, calculated at mouse press. See ensureDragBounds()
+    bool dragBoundsValid = false;
+    int dragMinPos = 0;
+    int dragMaxPos = 0;
 };
 
 Separator::Separator(Widget *hostWidget)
     : d(new Private(hostWidget))
 {
     s_numSeparators++;
+
+    if (d->usesCoalescedResize) {
+        d->coalescedMoveTimer.setSingleShot(true);
+        QObject::connect(&d->coalescedMoveTimer, &QTimer::timeout, &d->coalescedMoveTimer, [this] {
+            applyPendingMove();
+        });
+
+        // Zero timers only fire once the pending events were processed, which includes the
+        // repaint of the guests we just resized
+        d->repaintDoneTimer.setSingleShot(true);
+        d->repaintDoneTimer.setInterval(0);
+        QObject::connect(&d->repaintDoneTimer, &QTimer::timeout, &d->repaintDoneTimer, [this] {
+            d->lastMoveCostMs = d->sinceLastMove.elapsed();
+            if (d->lastMoveCostMs > s_frameBudgetMs)
+                qCDebug(separators) << Q_FUNC_INFO << "Resizing took" << d->lastMoveCostMs << "ms, dropping intermediate steps";
+        });
+    }
 }
 
 Separator::~Separator()
@@ -89,6 +125,9 @@ void Separator::onMousePress()
 
     qCDebug(separators) << "Drag started";
 
+    d->dragBoundsValid = false;
+    ensureDragBounds();
+
     if (d->lazyResizeRubberBand) {
         setLazyPosition(position());
         d->lazyResizeRubberBand->show();
@@ -124,8 +163,8 @@ void Separator::onMouseMove(QPoint pos)
 #endif
 
     const int positionToGoTo = Layouting::pos(pos, d->orientation);
-    const int minPos = d->parentContainer->minPosForSeparator_global(this);
-    const int maxPos = d->parentContainer->maxPosForSeparator_global(this);
+    const int minPos = minPositionForDrag();
+    const int maxPos = maxPositionForDrag();
 
     if ((positionToGoTo > maxPos && position() <= positionToGoTo) ||
         (positionToGoTo < minPos && position() >= positionToGoTo)) {
@@ -145,6 +184,8 @@ void Separator::onMouseMove(QPoint pos)
 
     if (d->lazyResizeRubberBand)
         setLazyPosition(positionToGoTo);
+    else if (d->usesCoalescedResize)
+        schedulePendingMove(positionToGoTo);
     else
         d->parentContainer->requestSeparatorMove(this, positionToGoTo - position());
 }
@@ -154,9 +195,57 @@ void Separator::onMouseReleased()
     if (d->lazyResizeRubberBand) {
         d->lazyResizeRubberBand->hide();
         d->parentContainer->requestSeparatorMove(this, d->lazyPosition - position());
+    } else if (d->usesCoalescedResize) {
+        // Flush whatever is still pending, so we end at the release position
+        d->coalescedMoveTimer.stop();
+        applyPendingMove();
     }
 
     s_separatorBeingDragged = nullptr;
+    d->dragBoundsValid = false;
+}
+
+void Separator::schedulePendingMove(int pos)
+{
+    // Any position we didn't get to apply yet is simply replaced, only the latest one matters
+    d->pendingPosition = pos;
+    if (d->coalescedMoveTimer.isActive())
+        return;
+
+    // Wait at least a frame since the last move started. If resizing and repainting the guests took
+    // longer than a frame wait that long instead, so the event loop can catch up and we drop the
+    // intermediate steps.
+    int delay = 0;
+    if (d->sinceLastMove.isValid()) {
+        const qint64 interval = qMax(qint64(s_frameBudgetMs), d->lastMoveCostMs);
+        delay = int(qMax(qint64(0), interval - d->sinceLastMove.elapsed()));
+    }
+
+    d->coalescedMoveTimer.start(delay);
+}
+
+void Separator::applyPendingMove()
+{
+    if (d->pendingPosition == -1)
+        return;
+
+    // The layout might have changed since the mouse event, so bound it again
+    const int minPos = minPositionForDrag();
+    const int maxPos = maxPositionForDrag();
+    const int positionToGoTo = minPos <= maxPos ? qBound(minPos, d->pendingPosition, maxPos)
+                                                : d->pendingPosition;
+    const int delta = positionToGoTo - position();
+    d->pendingPosition = -1;
+    if (delta == 0)
+        return;
+
+    d->sinceLastMove.start();
+    d->parentContainer->requestSeparatorMove(this, delta);
+
+    // The resize is only half of the cost, the repaint comes once we're back in the event loop.
+    // Use the resize alone until then, in case another move is scheduled meanwhile.
+    d->lastMoveCostMs = d->sinceLastMove.elapsed();
+    d->repaintDoneTimer.start();
 }
 
 void Separator::setGeometry(QRect r)
@@ -246,3 +335,33 @@ bool Separator::isBeingDragged() const
 {
     return s_separatorBeingDragged == this;
 }
+
+void Separator::ensureDragBounds()
+{
+    if (d->dragBoundsValid)
+        return;
+
+    d->dragMinPos = d->parentContainer->minPosForSeparator_global(this);
+    d->dragMaxPos = d->parentContainer->maxPosForSeparator_global(this);
+
+    // Only remember them while dragging, we're not notified of layout changes otherwise
+    d->dragBoundsValid = isBeingDragged();
+}
+
+int Separator::minPositionForDrag()
+{
+    ensureDragBounds();
+    return d->dragMinPos;
+}
+
+int Separator::maxPositionForDrag()
+{
+    ensureDragBounds();
+    return d->dragMaxPos;
+}
+
+void Separator::invalidateDragBounds()
+{
+    if (s_separatorBeingDragged)
+        s_separatorBeingDragged->d->dragBoundsValid = false;
+}
@@ -17,6 +17,8 @@
 #include <QObject>
 #include <QPoint>
 
+class TestMultiSplitter;
+
 namespace Layouting {
 
 class Config;
@@ -60,9 +62,22 @@ protected:
     void onMouseMove(QPoint pos);
 private:
     friend class Config;
+    friend class ItemBoxContainer;
+    friend class ::TestMultiSplitter;
 
     Q_DISABLE_COPY(Separator)
     void setLazyPosition(int);
+    void schedulePendingMove(int pos);
+    void applyPendingMove();
+
+    ///@brief Returns the allowed range for this separator, in root coordinates.
+    /// Memoized while the separator is being dragged, as moving it doesn't change the range.
+    int minPositionForDrag();
+    int maxPositionForDrag();
+    void ensureDragBounds();
+
+    ///@brief Called when the layout changed externally, so the dragged separator's range is stale
+    static void invalidateDragBounds();
     bool isBeingDragged() const;
     bool usesLazyResize() const;
     static bool s_isResizing;
@@ -14,7 +14,11 @@
 #include "Logging_p.h"
 #include "Item_p.h"
 #include "Rubberband_quick.h"
+#include "Qt5Qt6Compat_p.h"
 
+#include <QMouseEvent>
+#include <QQuickWindow>
+#include <QSGRectangleNode>
 #include <QTimer>
 
 using namespace Layouting;
@@ -24,7 +28,12 @@ SeparatorQuick::SeparatorQuick(Layouting::Widget *parent)
     , Separator(parent)
     , Layouting::Widget_quick(this)
 {
-    createQQuickItem(QStringLiteral(":/kddockwidgets/multisplitter/private/multisplitter/qml/Separator.qml"), this);
+    setFlag(ItemHasContents);
+    setAcceptedMouseButtons(Qt::LeftButton);
+
+    connect(this, &QQuickItem::widthChanged, this, &QQuickItem::update);
+    connect(this, &QQuickItem::heightChanged, this, &QQuickItem::update);
+    connect(this, &SeparatorQuick::isVerticalChanged, this, &SeparatorQuick::updateCursor);
 
     // Only set on Separator::init(), so single-shot
     QTimer::singleShot(0, this, &SeparatorQuick::isVerticalChanged);
@@ -50,23 +59,43 @@ Widget *SeparatorQuick::asWidget()
     return this;
 }
 
-void SeparatorQuick::onMousePressed()
+QSGNode *SeparatorQuick::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
 {
+    auto node = static_cast<QSGRectangleNode *>(oldNode);
+    if (!node) {
+        node = window()->createRectangleNode();
+        node->setColor(QColor(0xef, 0xf0, 0xf1));
+    }
+
+    node->setRect(boundingRect());
+    return node;
+}
+
+void SeparatorQuick::mousePressEvent(QMouseEvent *ev)
+{
+    ev->accept(); // So we get the move and release events
     Separator::onMousePress();
 }
 
-void SeparatorQuick::onMouseMoved(QPointF localPos)
+void SeparatorQuick::mouseMoveEvent(QMouseEvent *ev)
 {
-    const QPointF pos = QQuickItem::mapToItem(parentItem(), localPos);
+    const QPointF pos = QQuickItem::mapToItem(parentItem(), Qt5Qt6Compat::eventPos(ev));
     Separator::onMouseMove(pos.toPoint());
 }
 
-void SeparatorQuick::onMouseReleased()
+void SeparatorQuick::mouseReleaseEvent(QMouseEvent *)
 {
     Separator::onMouseReleased();
 }
 
-void SeparatorQuick::onMouseDoubleClicked()
+void SeparatorQuick::mouseDoubleClickEvent(QMouseEvent *)
 {
     Separator::onMouseDoubleClick();
 }
+
+void SeparatorQuick::updateCursor()
+{
+#if QT_CONFIG(cursor)
+    setCursor(isVertical() ? Qt::SizeVerCursor : Qt::SizeHorCursor);
+#endif
+}
@@ -36,12 +36,17 @@ protected:
     Widget* createRubberBand(Widget *parent) override;
     Widget *asWidget() override;
 
-public:
-    // Interface with QML:
-    Q_INVOKABLE void onMousePressed();
-    Q_INVOKABLE void onMouseMoved(QPointF localPos);
-    Q_INVOKABLE void onMouseReleased();
-    Q_INVOKABLE void onMouseDoubleClicked();
+    // Painted and handled in C++ instead of by a QML Rectangle and MouseArea per separator,
+    // as complex layouts have hundreds of them
+    QSGNode *updatePaintNode(QSGNode *, UpdatePaintNodeData *) override;
+    void mousePressEvent(QMouseEvent *) override;
+    void mouseMoveEvent(QMouseEvent *) override;
+    void mouseReleaseEvent(QMouseEvent *) override;
+    void mouseDoubleClickEvent(QMouseEvent *) override;
+
+private:
+    void updateCursor();
+
 Q_SIGNALS:
     // constant but it's only set after Separator::init
     void isVerticalChanged();
@@ -12,6 +12,9 @@
 #include "Widget_quick.h"
 
 #include <QDebug>
+#include <QHash>
+#include <QPointer>
+#include <QQmlComponent>
 #include <QQmlEngine>
 
 using namespace Layouting;
@@ -137,10 +140,10 @@ QQuickItem *Widget_quick::createQQuickItem(const QString &filename, QQuickItem *
         return nullptr;
     }
 
-    QQmlComponent component(engine, filename);
-    auto qquickitem = qobject_cast<QQuickItem*>(component.create());
+    QQmlComponent *component = componentForFile(engine, filename);
+    auto qquickitem = qobject_cast<QQuickItem*>(component->create());
     if (!qquickitem) {
-        qWarning() << Q_FUNC_INFO << component.errorString();
+        qWarning() << Q_FUNC_INFO << component->errorString();
         return nullptr;
     }
 
@@ -149,3 +152,16 @@ QQuickItem *Widget_quick::createQQuickItem(const QString &filename, QQuickItem *
 
     return qquickitem;
 }
+
+QQmlComponent *Widget_quick::componentForFile(QQmlEngine *engine, const QString &filename)
+{
+    // A layout can have hundreds of separators and frames, don't look up and
+    // load the same file for each one of them
+    static QHash<QPair<const QQmlEngine *, QString>, QPointer<QQmlComponent>> s_components;
+
+    QPointer<QQmlComponent> &component = s_components[qMakePair(static_cast<const QQmlEngine *>(engine), filename)];
+    if (!component)
+        component = new QQmlComponent(engine, filename, engine);
+
+    return component;
+}
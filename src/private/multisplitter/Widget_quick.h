@@ -17,6 +17,8 @@
 
 QT_BEGIN_NAMESPACE
 class QQuickItem;
+class QQmlComponent;
+class QQmlEngine;
 QT_END_NAMESPACE
 
 ///@file
@@ -57,6 +59,10 @@ public:
 
     static QSize widgetMinSize(const QWidget *w);
 
+    ///@brief Returns the component for @p filename, creating it only the first time
+    /// There's one per engine and file. They're children of the engine, so die with it.
+    static QQmlComponent *componentForFile(QQmlEngine *engine, const QString &filename);
+
 protected:
     QQuickItem *createQQuickItem(const QString &filename, QQuickItem *parent) const;
 
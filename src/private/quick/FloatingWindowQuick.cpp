@@ -165,6 +165,25 @@ QWindow *FloatingWindowQuick::candidateParentWindow() const
     return nullptr;
 }
 
+void FloatingWindowQuick::setTransientParentWindow(QWindow *transientParent)
+{
+    m_quickWindow->setTransientParent(transientParent);
+    if (transientParent) {
+        // This mimics the QWidget beaviour, where we not only have a transient parent but also
+        // a parent for cleanup. Calling QWindow::setParent() here would clip it to the parent
+        m_quickWindow->QObject::setParent(transientParent);
+        m_quickWindow->setObjectName(QStringLiteral("Floating QWindow with parent")); // for debug
+    } else {
+        m_quickWindow->QObject::setParent(nullptr);
+        m_quickWindow->setObjectName(QStringLiteral("Floating QWindow"));
+    }
+}
+
+void FloatingWindowQuick::setParentMainWindow(MainWindowBase *parent)
+{
+    setTransientParentWindow(parent ? parent->QQuickItem::window() : nullptr);
+}
+
 void FloatingWindowQuick::init()
 {
     connect(this, &QQuickItem::visibleChanged, this, [this] {
@@ -179,15 +198,7 @@ void FloatingWindowQuick::init()
     });*/
 
 
-    if (QWindow *transientParent = candidateParentWindow()) {
-        m_quickWindow->setTransientParent(candidateParentWindow());
-        // This mimics the QWidget beaviour, where we not only have a transient parent but also
-        // a parent for cleanup. Calling QWindow::setParent() here would clip it to the parent
-        m_quickWindow->QObject::setParent(transientParent);
-        m_quickWindow->setObjectName(QStringLiteral("Floating QWindow with parent")); // for debug
-    } else {
-        m_quickWindow->setObjectName(QStringLiteral("Floating QWindow"));
-    }
+    setTransientParentWindow(candidateParentWindow());
 
     QWidgetAdapter::setParent(m_quickWindow->contentItem());
     WidgetResizeHandler::setupWindow(m_quickWindow);
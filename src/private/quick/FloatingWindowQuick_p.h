@@ -30,11 +30,13 @@ public:
 
 protected:
     void setGeometry(QRect) override;
+    void setParentMainWindow(MainWindowBase *) override;
 
 private:
     int contentsMargins() const;
     int titleBarHeight() const;
     QWindow *candidateParentWindow() const;
+    void setTransientParentWindow(QWindow *);
     void init();
     QQuickView *const m_quickWindow;
     QQuickItem *m_visualItem = nullptr;
@@ -23,7 +23,9 @@
 #include "TabWidgetQuick_p.h"
 #include "WidgetResizeHandler_p.h"
 #include "DockWidgetQuick.h"
+#include "Widget_quick.h"
 #include <QDebug>
+#include <QQmlComponent>
 
 using namespace KDDockWidgets;
 
@@ -38,25 +40,46 @@ FrameQuick::FrameQuick(QWidgetAdapter *parent, FrameOptions options, int userTyp
 
     connect(this, &QWidgetAdapter::geometryUpdated, this, &Frame::layoutInvalidated);
 
+    // The dock widgets are told in the polish phase, so only once per frame even if the
+    // position and the size changed separately
     connect(this, &QWidgetAdapter::itemGeometryChanged, this, [this] {
-        for (auto dw : dockWidgets()) {
-            Q_EMIT static_cast<DockWidgetQuick*>(dw)->frameGeometryChanged(QWidgetAdapter::geometry());
-        }
+        polish();
     });
 
-    QQmlComponent component(Config::self().qmlEngine(),
-                            Config::self().frameworkWidgetFactory()->frameFilename());
+    QQmlComponent *component = Layouting::Widget_quick::componentForFile(Config::self().qmlEngine(),
+                                                                          Config::self().frameworkWidgetFactory()->frameFilename().toString());
 
-    m_visualItem = static_cast<QQuickItem*>(component.create());
+    m_visualItem = static_cast<QQuickItem*>(component->create());
 
     if (!m_visualItem) {
-        qWarning() << Q_FUNC_INFO << "Failed to create item" << component.errorString();
+        qWarning() << Q_FUNC_INFO << "Failed to create item" << component->errorString();
         return;
     }
 
     m_visualItem->setProperty("frameCpp", QVariant::fromValue(this));
     m_visualItem->setParentItem(this);
     m_visualItem->setParent(this);
+
+    applyOptions();
+}
+
+void FrameQuick::applyOptions()
+{
+    // Frame.qml doesn't read the options directly, only what's derived from them
+    Q_EMIT hasTabsVisibleChanged();
+    Q_EMIT actualTitleBarChanged();
+}
+
+void FrameQuick::updatePolish()
+{
+    const QRect geo = QWidgetAdapter::geometry();
+    if (geo == m_lastNotifiedGeometry)
+        return;
+
+    m_lastNotifiedGeometry = geo;
+    for (auto dw : dockWidgets()) {
+        Q_EMIT static_cast<DockWidgetQuick*>(dw)->frameGeometryChanged(geo);
+    }
 }
 
 FrameQuick::~FrameQuick()
@@ -76,7 +99,7 @@ FrameQuick::~FrameQuick()
 
 void FrameQuick::updateConstriants()
 {
-    onDockWidgetCountChanged();
+    // onDockWidgetCountChanged() was already called by TabWidget::onTabInserted()/onTabRemoved()
 
     // QtQuick doesn't have layouts, so we need to do constraint propagation manually
 
@@ -65,6 +65,9 @@ protected:
 
     Q_INVOKABLE void setStackLayout(QQuickItem *);
 
+    void updatePolish() override;
+    void applyOptions() override;
+
     int nonContentsHeight() const override;
 
 Q_SIGNALS:
@@ -76,6 +79,7 @@ public Q_SLOTS:
 private:
     QQuickItem *m_stackLayout = nullptr;
     QQuickItem *m_visualItem = nullptr;
+    QRect m_lastNotifiedGeometry;
     QHash<DockWidgetBase *, QMetaObject::Connection> m_connections; // To make it easy to disconnect from lambdas
 };
 
@@ -23,6 +23,7 @@
 #include "MainWindowBase.h"
 #include "DockRegistry_p.h"
 #include "Utils_p.h"
+#include "Widget_quick.h"
 
 #include <QResizeEvent>
 #include <QMouseEvent>
@@ -124,18 +125,6 @@ QWidgetAdapter::QWidgetAdapter(QQuickItem *parent, Qt::WindowFlags flags)
         QObject::setParent(parent);
     }
 
-    connect(this, &QQuickItem::widthChanged, this, [this] {
-        onResize(size());
-        updateGeometry();
-    });
-
-    connect(this, &QQuickItem::heightChanged, this, [this] {
-        if (!m_windowIsBeingDestroyed) { // If Window is being destroyed we don't bother
-            onResize(size());
-            updateGeometry();
-        }
-    });
-
     setSize(QSize(800, 800));
 }
 
@@ -197,6 +186,12 @@ void QWidgetAdapter::QQUICKITEMgeometryChanged(const QRectF &newGeometry, const
     // Send a few events manually, since QQuickItem doesn't do it for us.
     QQuickItem::QQUICKITEMgeometryChanged(newGeometry, oldGeometry);
 
+    // Once per geometry change, instead of once for widthChanged() and again for heightChanged()
+    if (newGeometry.size() != oldGeometry.size() && !m_windowIsBeingDestroyed) { // If Window is being destroyed we don't bother
+        onResize(size());
+        updateGeometry();
+    }
+
     // Not calling event() directly, otherwise it would skip event filters
 
     if (newGeometry.size() != oldGeometry.size()) {
@@ -311,8 +306,9 @@ void QWidgetAdapter::setFixedWidth(int width)
 
 void QWidgetAdapter::setGeometry(QRect rect)
 {
-    setWidth(rect.width());
-    setHeight(rect.height());
+    // Size and position are set in one go each, setting x, y, width and height separately would
+    // run the geometry change handlers four times
+    QQuickItem::setSize(QSizeF(rect.size()));
     move(rect.topLeft());
 }
 
@@ -372,8 +368,7 @@ void QWidgetAdapter::updateGeometry()
 
 void QWidgetAdapter::resize(QSize sz)
 {
-    setWidth(sz.width());
-    setHeight(sz.height());
+    QQuickItem::setSize(QSizeF(sz));
 }
 
 void QWidgetAdapter::resize(int w, int h)
@@ -547,8 +542,7 @@ void QWidgetAdapter::move(int x, int y)
         }
     }
 
-    setX(x);
-    setY(y);
+    setPosition(QPointF(x, y));
     setAttribute(Qt::WA_Moved);
 }
 
@@ -611,10 +605,10 @@ Qt::WindowFlags QWidgetAdapter::windowFlags() const
 /** static */
 QQuickItem *QWidgetAdapter::createItem(QQmlEngine *engine, const QString &filename)
 {
-    QQmlComponent component(engine, filename);
-    QObject *obj = component.create();
+    QQmlComponent *component = Layouting::Widget_quick::componentForFile(engine, filename);
+    QObject *obj = component->create();
     if (!obj) {
-        qWarning() << Q_FUNC_INFO << component.errorString();
+        qWarning() << Q_FUNC_INFO << component->errorString();
         return nullptr;
     }
 
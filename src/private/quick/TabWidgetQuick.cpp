@@ -27,6 +27,14 @@ TabWidgetQuick::TabWidgetQuick(Frame *parent)
 {
     connect(m_dockWidgetModel, &DockWidgetModel::countChanged,
             this, &TabWidgetQuick::countChanged);
+
+    // The model only inserts and removes one row at a time
+    connect(m_dockWidgetModel, &DockWidgetModel::rowsInserted, this, [this] (const QModelIndex &, int first) {
+        onTabInserted(first);
+    });
+    connect(m_dockWidgetModel, &DockWidgetModel::rowsRemoved, this, [this] (const QModelIndex &, int first) {
+        onTabRemoved(first);
+    });
 }
 
 TabBar *TabWidgetQuick::tabBar() const
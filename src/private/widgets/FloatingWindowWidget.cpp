@@ -55,6 +55,12 @@ void FloatingWindowWidget::paintEvent(QPaintEvent *ev)
     p.drawRect(rectf.adjusted(halfPenWidth, halfPenWidth, -halfPenWidth, -halfPenWidth));
 }
 
+void FloatingWindowWidget::setParentMainWindow(MainWindowBase *parent)
+{
+    // QWidget::setParent() would reset the window flags, turning us into a child widget
+    QWidget::setParent(parent, windowFlags());
+}
+
 bool FloatingWindowWidget::event(QEvent *ev)
 {
     if (ev->type() == QEvent::WindowStateChange) {
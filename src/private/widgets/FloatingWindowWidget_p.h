@@ -30,6 +30,7 @@ public:
 protected:
     void paintEvent(QPaintEvent *) override;
     bool event(QEvent *ev) override;
+    void setParentMainWindow(MainWindowBase *) override;
 
     QVBoxLayout *const m_vlayout;
     QMetaObject::Connection m_screenChangedConnection;
@@ -58,10 +58,15 @@ FrameWidget::FrameWidget(QWidget *parent, FrameOptions options, int userType)
     vlayout->addWidget(titleBar());
     vlayout->addWidget(m_tabWidget->asWidget());
 
+    applyOptions();
+}
+
+void FrameWidget::applyOptions()
+{
     m_tabWidget->setTabBarAutoHide(!alwaysShowsTabs());
 
-    if (isOverlayed())
-        setAutoFillBackground(true);
+    // Overlays are on top of the layout, they can't be transparent
+    setAutoFillBackground(isOverlayed());
 }
 
 FrameWidget::~FrameWidget()
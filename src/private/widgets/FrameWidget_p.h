@@ -40,6 +40,7 @@ public:
 protected:
     void paintEvent(QPaintEvent *) override;
     QSize maxSizeHint() const override;
+    void applyOptions() override;
     int indexOfDockWidget_impl(const DockWidgetBase *) override;
     void setCurrentDockWidget_impl(DockWidgetBase *) override;
     int currentIndex_impl() const override;
@@ -21,8 +21,11 @@
 #include "Config.h"
 #include "FrameworkWidgetFactory.h"
 
+#include <QMenu>
 #include <QMouseEvent>
+#include <QPointer>
 #include <QTabBar>
+#include <QToolButton>
 
 using namespace KDDockWidgets;
 
@@ -53,10 +56,61 @@ TabWidgetWidget::TabWidgetWidget(Frame *parent)
         Q_EMIT currentDockWidgetChanged(currentDockWidget());
     });
 
+    // QTabWidget moves the page along with the tab, but doesn't tell us
+    connect(QTabWidget::tabBar(), &QTabBar::tabMoved, this, [this] (int from, int to) {
+        onTabMoved(from, to);
+    });
+
+    if (Config::self().flags() & Config::Flag_TabOverflowMenu)
+        setupOverflowMenu();
+
     if (!QTabWidget::tabBar()->isVisible())
         setFocusProxy(nullptr);
 }
 
+void TabWidgetWidget::setupOverflowMenu()
+{
+    m_overflowButton = new QToolButton(this);
+    m_overflowButton->setObjectName(QStringLiteral("tabOverflowButton"));
+    m_overflowButton->setAutoRaise(true);
+    m_overflowButton->setArrowType(Qt::DownArrow);
+    m_overflowButton->setPopupMode(QToolButton::InstantPopup);
+    m_overflowButton->setToolTip(tr("All tabs"));
+
+    // Filled only when shown, so having many tabs doesn't mean having as many actions
+    auto menu = new QMenu(m_overflowButton);
+    connect(menu, &QMenu::aboutToShow, this, [this, menu] {
+        menu->clear();
+        const int current = QTabWidget::currentIndex();
+        for (int i = 0, num = QTabWidget::count(); i < num; ++i) {
+            QAction *action = menu->addAction(tabIcon(i), tabText(i));
+            action->setCheckable(true);
+            action->setChecked(i == current);
+
+            QPointer<DockWidgetBase> dw = dockwidgetAt(i);
+            connect(action, &QAction::triggered, this, [this, dw] {
+                if (dw)
+                    TabWidget::setCurrentDockWidget(dw.data());
+            });
+        }
+    });
+
+    m_overflowButton->setMenu(menu);
+    setCornerWidget(m_overflowButton, Qt::TopRightCorner);
+    updateOverflowButton();
+}
+
+void TabWidgetWidget::updateOverflowButton()
+{
+    if (!m_overflowButton)
+        return;
+
+    QTabBar *tabBar = QTabWidget::tabBar();
+    const bool overflows = tabBar->isVisible() && QTabWidget::count() > 1
+                           && tabBar->sizeHint().width() > width();
+    m_overflowButton->setVisible(overflows);
+}
+
 TabBar *TabWidgetWidget::tabBar() const
 {
     return m_tabBar;
@@ -96,14 +150,22 @@ void TabWidgetWidget::mousePressEvent(QMouseEvent *ev)
     }
 }
 
-void TabWidgetWidget::tabInserted(int)
+void TabWidgetWidget::resizeEvent(QResizeEvent *ev)
+{
+    QTabWidget::resizeEvent(ev);
+    updateOverflowButton();
+}
+
+void TabWidgetWidget::tabInserted(int index)
 {
-    onTabInserted();
+    onTabInserted(index);
+    updateOverflowButton();
 }
 
-void TabWidgetWidget::tabRemoved(int)
+void TabWidgetWidget::tabRemoved(int index)
 {
-    onTabRemoved();
+    onTabRemoved(index);
+    updateOverflowButton();
 }
 
 bool TabWidgetWidget::isPositionDraggable(QPoint p) const
@@ -136,11 +198,13 @@ void TabWidgetWidget::setTabBarAutoHide(bool b)
 void TabWidgetWidget::renameTab(int index, const QString &text)
 {
     setTabText(index, text);
+    updateOverflowButton(); // The tabs' width changed
 }
 
 void TabWidgetWidget::changeTabIcon(int index, const QIcon &icon)
 {
     setTabIcon(index, icon);
+    updateOverflowButton();
 }
 
 DockWidgetBase *TabWidgetWidget::dockwidgetAt(int index) const
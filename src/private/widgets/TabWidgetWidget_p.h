@@ -23,6 +23,10 @@
 
 #include <QTabWidget>
 
+QT_BEGIN_NAMESPACE
+class QToolButton;
+QT_END_NAMESPACE
+
 namespace KDDockWidgets {
 
 class Frame;
@@ -48,6 +52,7 @@ Q_SIGNALS:
 protected:
     void mouseDoubleClickEvent(QMouseEvent *) override;
     void mousePressEvent(QMouseEvent *) override;
+    void resizeEvent(QResizeEvent *) override;
     void tabInserted(int index) override;
     void tabRemoved(int index) override;
     bool isPositionDraggable(QPoint p) const override;
@@ -62,7 +67,15 @@ protected:
 
 private:
     Q_DISABLE_COPY(TabWidgetWidget)
+
+    ///@brief Creates the button for Config::Flag_TabOverflowMenu
+    void setupOverflowMenu();
+
+    ///@brief Shows the overflow button only if the tabs don't fit
+    void updateOverflowButton();
+
     TabBar *const m_tabBar;
+    QToolButton *m_overflowButton = nullptr;
 };
 }
 
@@ -0,0 +1,261 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2021 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+// We don't care about performance related checks in the tests
+// clazy:excludeall=ctor-missing-parent-argument,missing-qobject-macro,range-loop,missing-typeinfo,detaching-member,function-args-by-ref,non-pod-global-static,reserve-candidates,qstring-allocations
+
+#include "Replayer.h"
+#include "Config.h"
+#include "DockRegistry_p.h"
+#include "DockWidget.h"
+#include "LayoutSaver.h"
+#include "MainWindow.h"
+#include "SessionRecorder_p.h"
+
+#include <QApplication>
+#include <QCursor>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QMap>
+#include <QTest>
+#include <QWidget>
+#include <QWindow>
+#include <QDebug>
+
+#include <qpa/qwindowsysteminterface.h>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace KDDockWidgets;
+using namespace KDDockWidgets::Testing;
+
+static QString eventTypeName(QEvent::Type type)
+{
+    switch (type) {
+    case QEvent::MouseButtonPress:
+        return QStringLiteral("press");
+    case QEvent::MouseButtonRelease:
+        return QStringLiteral("release");
+    case QEvent::MouseButtonDblClick:
+        return QStringLiteral("dblclick");
+    case QEvent::MouseMove:
+        return QStringLiteral("move");
+    default:
+        return QString::number(type);
+    }
+}
+
+static QWindow *windowAt(QPoint globalPos)
+{
+    if (QWidget *grabber = QWidget::mouseGrabber())
+        return grabber->window()->windowHandle();
+
+    const QVector<QWindow *> topLevels = DockRegistry::self()->topLevels();
+    for (QWindow *window : topLevels) {
+        if (window->geometry().contains(globalPos))
+            return window;
+    }
+
+    return nullptr;
+}
+
+Replayer::Replayer(Options options)
+    : m_options(options)
+{
+}
+
+bool Replayer::load(const QString &filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << Q_FUNC_INFO << "Failed to open" << filename;
+        return false;
+    }
+
+    const QVariantMap map = QJsonDocument::fromJson(file.readAll()).toVariant().toMap();
+    m_layout = QJsonDocument::fromVariant(map["layout"]).toJson();
+    m_events.clear();
+
+    const QVariantList events = map["events"].toList();
+    m_events.reserve(events.size());
+    for (const QVariant &v : events) {
+        const QVariantMap eventMap = v.toMap();
+        const QVariantMap globalPos = eventMap["globalPos"].toMap();
+
+        Event ev;
+        ev.time = eventMap["time"].toLongLong();
+        ev.type = QEvent::Type(eventMap["type"].toInt());
+        ev.window = eventMap["window"].toString();
+        ev.globalPos = { globalPos["x"].toInt(), globalPos["y"].toInt() };
+        ev.button = Qt::MouseButton(eventMap["button"].toInt());
+        ev.buttons = Qt::MouseButtons(eventMap["buttons"].toInt());
+        ev.modifiers = Qt::KeyboardModifiers(eventMap["modifiers"].toInt());
+        m_events.push_back(ev);
+    }
+
+    if (m_events.isEmpty()) {
+        qWarning() << Q_FUNC_INFO << "No events in" << filename;
+        return false;
+    }
+
+    return true;
+}
+
+bool Replayer::restoreLayout()
+{
+    // Same as the layout linter, we create whatever the layout needs
+    Config::self().setDockWidgetFactoryFunc([] (const QString &name) {
+        auto dw = new DockWidget(name);
+        dw->setWidget(new QWidget());
+        return static_cast<DockWidgetBase *>(dw);
+    });
+
+    Config::self().setMainWindowFactoryFunc([] (const QString &name) {
+        auto mw = new MainWindow(name);
+        mw->show();
+        return static_cast<MainWindowBase *>(mw);
+    });
+
+    LayoutSaver saver;
+    if (!saver.restoreLayout(m_layout)) {
+        qWarning() << Q_FUNC_INFO << "Failed to restore the starting layout";
+        return false;
+    }
+
+    // Let windows get exposed before we start sending them events
+    QTest::qWait(100);
+
+    return true;
+}
+
+bool Replayer::replay(Event &ev)
+{
+    QWindow *window = Debug::SessionRecorder::windowForKey(ev.window);
+    if (!window)
+        window = windowAt(ev.globalPos);
+
+    if (!window) {
+        qWarning() << Q_FUNC_INFO << "No window for event at" << ev.globalPos << ev.window;
+        return false;
+    }
+
+    // Qt synthesizes double-clicks from the presses, like it did when recording
+    if (ev.type == QEvent::MouseButtonDblClick)
+        return true;
+
+    // Some code uses QCursor::pos() instead of the event's position
+    QCursor::setPos(ev.globalPos);
+
+    // Inject through QPA, like the platform does. Sending a QMouseEvent directly wouldn't update
+    // QGuiApplication::mouseButtons(), which separators and DragController rely on.
+    const QPointF localPos = window->mapFromGlobal(ev.globalPos);
+
+    QElapsedTimer timer;
+    timer.start();
+    QWindowSystemInterface::handleMouseEvent<QWindowSystemInterface::SynchronousDelivery>(
+        window, ulong(ev.time), localPos, QPointF(ev.globalPos), ev.buttons, ev.button, ev.type, ev.modifiers);
+    ev.nsecs = timer.nsecsElapsed();
+
+    // Deferred work (deleteLater(), queued relayouts) isn't accounted to the event
+    qApp->processEvents();
+
+    return true;
+}
+
+bool Replayer::run()
+{
+    if (!restoreLayout())
+        return false;
+
+    qint64 previousTime = 0;
+    for (Event &ev : m_events) {
+        if ((m_options & Option_RealTime) && ev.time > previousTime)
+            QTest::qWait(int(ev.time - previousTime));
+        previousTime = ev.time;
+
+        if (!replay(ev))
+            return false;
+    }
+
+    DockRegistry::self()->checkSanityAll();
+
+    return true;
+}
+
+void Replayer::printReport() const
+{
+    struct Stats {
+        int count = 0;
+        qint64 total = 0;
+        qint64 max = 0;
+    };
+
+    QMap<QString, Stats> statsPerType;
+    for (const Event &ev : m_events) {
+        if (ev.nsecs < 0)
+            continue;
+        Stats &stats = statsPerType[eventTypeName(ev.type)];
+        stats.count++;
+        stats.total += ev.nsecs;
+        stats.max = std::max(stats.max, ev.nsecs);
+    }
+
+    std::cout << "type       count   total(ms)   mean(us)    max(us)\n";
+    for (auto it = statsPerType.cbegin(), end = statsPerType.cend(); it != end; ++it) {
+        const Stats &stats = it.value();
+        std::cout << it.key().leftJustified(10).toStdString() << " "
+                  << QString::number(stats.count).rightJustified(5).toStdString() << " "
+                  << QString::number(stats.total / 1000000.0, 'f', 2).rightJustified(11).toStdString() << " "
+                  << QString::number(stats.total / stats.count / 1000.0, 'f', 1).rightJustified(10).toStdString() << " "
+                  << QString::number(stats.max / 1000.0, 'f', 1).rightJustified(10).toStdString() << "\n";
+    }
+
+    QVector<int> indexes;
+    indexes.reserve(m_events.size());
+    for (int i = 0; i < m_events.size(); ++i)
+        indexes.push_back(i);
+
+    std::sort(indexes.begin(), indexes.end(), [this] (int a, int b) {
+        return m_events.at(a).nsecs > m_events.at(b).nsecs;
+    });
+
+    std::cout << "\nSlowest events:\n";
+    for (int i = 0; i < std::min(10, int(indexes.size())); ++i) {
+        const Event &ev = m_events.at(indexes.at(i));
+        std::cout << "#" << indexes.at(i) << " " << eventTypeName(ev.type).toStdString()
+                  << " on " << ev.window.toStdString()
+                  << ": " << QString::number(ev.nsecs / 1000.0, 'f', 1).toStdString() << "us\n";
+    }
+}
+
+bool Replayer::saveReport(const QString &filename) const
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << Q_FUNC_INFO << "Failed to open" << filename;
+        return false;
+    }
+
+    QVariantList events;
+    events.reserve(m_events.size());
+    for (const Event &ev : m_events) {
+        QVariantMap map;
+        map["type"] = eventTypeName(ev.type);
+        map["window"] = ev.window;
+        map["nsecs"] = ev.nsecs;
+        events.push_back(map);
+    }
+
+    file.write(QJsonDocument::fromVariant(events).toJson());
+    return true;
+}
@@ -0,0 +1,83 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2021 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+// We don't care about performance related checks in the tests
+// clazy:excludeall=ctor-missing-parent-argument,missing-qobject-macro,range-loop,missing-typeinfo,detaching-member,function-args-by-ref,non-pod-global-static,reserve-candidates,qstring-allocations
+
+#ifndef KDDOCKWIDGETS_REPLAYER_H
+#define KDDOCKWIDGETS_REPLAYER_H
+
+#include <QByteArray>
+#include <QEvent>
+#include <QPoint>
+#include <QString>
+#include <QVector>
+
+namespace KDDockWidgets {
+namespace Testing {
+
+/**
+ * @brief Replays a session recorded by Debug::SessionRecorder and measures how long
+ * each mouse event took to process.
+ *
+ * The starting layout is restored first, then each event is sent to the window it was recorded
+ * on. By default events are sent back to back, so timings don't depend on how fast the user was.
+ */
+class Replayer
+{
+public:
+    enum Option {
+        Option_None = 0,
+        Option_RealTime = 1 ///< Honour the delays between events, as they were recorded
+    };
+    Q_DECLARE_FLAGS(Options, Option)
+
+    struct Event {
+        typedef QVector<Event> List;
+        qint64 time = 0; ///< msecs since the first press, as recorded
+        QEvent::Type type = QEvent::None;
+        QString window;
+        QPoint globalPos;
+        Qt::MouseButton button = Qt::NoButton;
+        Qt::MouseButtons buttons = Qt::NoButton;
+        Qt::KeyboardModifiers modifiers = Qt::NoModifier;
+        qint64 nsecs = -1; ///< processing time, filled by run(). Double-clicks are accounted to their press
+    };
+
+    explicit Replayer(Options options = Option_None);
+
+    ///@brief Loads a session json file, as written by Debug::SessionRecorder
+    bool load(const QString &filename);
+
+    ///@brief Restores the starting layout and replays all events. Returns false on error.
+    bool run();
+
+    ///@brief Prints per event type statistics and the slowest events to stdout
+    void printReport() const;
+
+    ///@brief Saves the per-event timings to @p filename, so runs can be compared
+    bool saveReport(const QString &filename) const;
+
+private:
+    bool restoreLayout();
+    bool replay(Event &);
+
+    const Options m_options;
+    QByteArray m_layout;
+    Event::List m_events;
+};
+
+}
+}
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(KDDockWidgets::Testing::Replayer::Options)
+
+#endif
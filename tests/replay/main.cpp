@@ -0,0 +1,93 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2021 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+// We don't care about performance related checks in the tests
+// clazy:excludeall=ctor-missing-parent-argument,missing-qobject-macro,range-loop,missing-typeinfo,detaching-member,function-args-by-ref,non-pod-global-static,reserve-candidates,qstring-allocations
+
+#include "Replayer.h"
+#include "../utils.h"
+
+#include <QCommandLineParser>
+#include <QApplication>
+#include <QTimer>
+#include <QFile>
+#include <iostream>
+
+using namespace KDDockWidgets;
+using namespace KDDockWidgets::Testing;
+
+int main(int argc, char **argv)
+{
+    if (!qpaPassedAsArgument(argc, argv)) {
+        // Use offscreen by default as it's less annoying, doesn't create visible windows
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Replays a session recorded with KDDOCKWIDGETS_RECORD_SESSION=<file.json> and reports how long each mouse event took");
+    parser.addPositionalArgument("json", QCoreApplication::translate("main", "session json file to replay"));
+
+    QCommandLineOption realTimeOption("t", QCoreApplication::translate("main", "Keep the delays between events, as recorded"));
+    parser.addOption(realTimeOption);
+
+    QCommandLineOption outputOption("o", QCoreApplication::translate("main", "Save per-event timings to <file>"), "file");
+    parser.addOption(outputOption);
+
+    QCommandLineOption noQuitOption("n", QCoreApplication::translate("main", "Don't quit at the end, keep event loop running for debugging"));
+    parser.addOption(noQuitOption);
+
+    parser.addHelpOption();
+    parser.process(app);
+
+    const QStringList positionalArguments = parser.positionalArguments();
+    if (positionalArguments.size() != 1) {
+        parser.showHelp(1);
+    }
+
+    const QString file = positionalArguments.first();
+    if (!QFile::exists(file)) {
+        std::cerr << "\nFile doesn't exist: " << file.toStdString() << "\n";
+        return 1;
+    }
+
+    Replayer::Options options = Replayer::Option_None;
+    if (parser.isSet(realTimeOption))
+        options |= Replayer::Option_RealTime;
+
+    Replayer replayer(options);
+    if (!replayer.load(file))
+        return 1;
+
+    const QString outputFile = parser.value(outputOption);
+    const bool noQuit = parser.isSet(noQuitOption);
+    int result = 0;
+
+    QTimer::singleShot(0, &app, [&app, &replayer, &result, outputFile, noQuit] {
+        if (replayer.run()) {
+            replayer.printReport();
+            if (!outputFile.isEmpty() && !replayer.saveReport(outputFile))
+                result = 1;
+        } else {
+            result = 2;
+        }
+
+        if (!noQuit) {
+            // if noQuit is true we keep the app running so it can be debugged
+            app.quit();
+        }
+    });
+
+    app.setQuitOnLastWindowClosed(false);
+    app.exec();
+    return result;
+}
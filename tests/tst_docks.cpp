@@ -17,6 +17,7 @@
 #include "DockWidgetBase.h"
 #include "DockWidgetBase_p.h"
 #include "DropAreaWithCentralFrame_p.h"
+#include "FrameworkWidgetFactory.h"
 #include "LayoutSaver_p.h"
 #include "MDILayoutWidget_p.h"
 #include "MainWindowMDI.h"
@@ -24,11 +25,26 @@
 #include "SideBar_p.h"
 #include "TabWidget_p.h"
 #include "TitleBar_p.h"
+#include "Tracer_p.h"
+#include "WidgetResizeHandler_p.h"
 #include "WindowBeingDragged_p.h"
 #include "multisplitter/Separator_p.h"
 #include "private/MultiSplitter_p.h"
 
 #include <QAction>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+# include "replay/Replayer.h"
+# include "SessionRecorder_p.h"
+# include <QToolButton>
+#else
+# include "multisplitter/Separator_quick.h"
+# include "multisplitter/Widget_quick.h"
+# include <QQmlComponent>
+#endif
 
 #ifdef Q_OS_WIN
 # include <windows.h>
@@ -935,6 +951,68 @@ void TestDocks::tst_hoverShowsDropIndicators()
 
     QCOMPARE(dock0->dptr()->frame()->dockWidgetCount(), 2);
 }
+
+void TestDocks::tst_qmlComponentsCached()
+{
+    // Tests that frames share the same QQmlComponent, instead of loading Frame.qml each time
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget("dock1", new MyWidget2(QSize(100, 100)));
+    auto dock2 = createDockWidget("dock2", new MyWidget2(QSize(100, 100)));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    QVERIFY(dock1->dptr()->frame() != dock2->dptr()->frame());
+
+    QQmlEngine *engine = Config::self().qmlEngine();
+    const QString filename = Config::self().frameworkWidgetFactory()->frameFilename().toString();
+    QQmlComponent *component = Layouting::Widget_quick::componentForFile(engine, filename);
+    QVERIFY(component);
+    QVERIFY(component->isReady());
+    QCOMPARE(Layouting::Widget_quick::componentForFile(engine, filename), component);
+    QCOMPARE(component->parent(), static_cast<QObject *>(engine));
+}
+
+void TestDocks::tst_separatorsArePlainItems()
+{
+    // Tests that separators don't instantiate any QML, they paint and handle the mouse themselves
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget("dock1", new MyWidget2(QSize(100, 100)));
+    auto dock2 = createDockWidget("dock2", new MyWidget2(QSize(100, 100)));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    const auto separators = m->multiSplitter()->separators();
+    QCOMPARE(separators.size(), 1);
+    auto separator = dynamic_cast<Layouting::SeparatorQuick *>(separators.first());
+    QVERIFY(separator);
+    QVERIFY(separator->childItems().isEmpty());
+    QVERIFY(separator->flags() & QQuickItem::ItemHasContents);
+    QCOMPARE(separator->acceptedMouseButtons(), Qt::MouseButtons(Qt::LeftButton));
+}
+
+void TestDocks::tst_frameGeometryChangedCoalesced()
+{
+    // Tests that moving and resizing a frame tells its dock widgets only once
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget("dock1", new MyWidget2(QSize(100, 100)));
+    m->addDockWidget(dock1, Location_OnLeft);
+    QTest::qWait(100);
+
+    auto dockQuick = static_cast<DockWidgetQuick *>(dock1);
+    QSignalSpy spy(dockQuick, &DockWidgetQuick::frameGeometryChanged);
+
+    Frame *frame = dock1->dptr()->frame();
+    const QRect newGeometry = frame->QWidgetAdapter::geometry().adjusted(10, 10, -10, -10);
+    frame->QWidgetAdapter::setGeometry(newGeometry);
+    QCOMPARE(spy.count(), 0);
+
+    QTRY_COMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toRect(), newGeometry);
+    QTest::qWait(50);
+    QCOMPARE(spy.count(), 1);
+}
 #endif
 
 void TestDocks::tst_28NestedWidgets_data()
@@ -2720,6 +2798,38 @@ void TestDocks::tst_isFocused()
     delete dock2->window();
 }
 
+void TestDocks::tst_focusMovesBetweenFrames()
+{
+    // Focus scopes are told about focus changes by DockRegistry. Tests that both the scope
+    // losing focus and the one getting it are updated.
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget(QStringLiteral("dock1"), new FocusableWidget());
+    auto dock2 = createDockWidget(QStringLiteral("dock2"), new FocusableWidget());
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    Frame *frame1 = dock1->dptr()->frame();
+    Frame *frame2 = dock2->dptr()->frame();
+    QVERIFY(frame1 != frame2);
+
+    dock1->raiseAndActivate();
+    if (!dock1->window()->windowHandle()->isActive())
+        Testing::waitForEvent(dock1->window()->windowHandle(), QEvent::WindowActivate);
+
+    dock1->widget()->setFocus(Qt::OtherFocusReason);
+    QTRY_VERIFY(frame1->isFocused());
+    QVERIFY(!frame2->isFocused());
+
+    dock2->widget()->setFocus(Qt::OtherFocusReason);
+    QTRY_VERIFY(frame2->isFocused());
+    QVERIFY(!frame1->isFocused());
+
+    dock1->widget()->setFocus(Qt::OtherFocusReason);
+    QTRY_VERIFY(frame1->isFocused());
+    QVERIFY(!frame2->isFocused());
+}
+
 void TestDocks::tst_setWidget()
 {
     EnsureTopLevelsDeleted e;
@@ -5300,6 +5410,222 @@ void TestDocks::tst_overlayCrash()
     pressOn(tb->mapToGlobal(QPoint(5, 5)), tb);
 }
 
+void TestDocks::tst_framePool()
+{
+    // Tests that empty frames are recycled instead of deleted, when a pool is set
+    EnsureTopLevelsDeleted e;
+    KDDockWidgets::Config::self().setFlags(KDDockWidgets::Config::Flag_AutoHideSupport);
+    FrameworkWidgetFactory *factory = Config::self().frameworkWidgetFactory();
+    factory->setFramePoolSize(1);
+
+    auto m1 = createMainWindow(QSize(1000, 1000), MainWindowOption_None, "MW1");
+    auto dw1 = new DockWidgetType(QStringLiteral("1"));
+    m1->addDockWidget(dw1, Location_OnBottom);
+    auto dw2 = new DockWidgetType(QStringLiteral("2"));
+    m1->addDockWidget(dw2, Location_OnTop);
+
+    Frame *frame1 = dw1->dptr()->frame();
+    m1->moveToSideBar(dw1);
+
+    // The empty frame went into the pool instead of being deleted
+    QTRY_COMPARE(factory->dbg_numPooledFrames(), 1);
+    QVERIFY(!DockRegistry::self()->frames().contains(frame1));
+    QVERIFY(frame1->titleBar()->title().isEmpty());
+    QVERIFY(!frame1->layoutItem());
+    QVERIFY(!frame1->isFocused());
+    QVERIFY(!frame1->focusedWidget());
+    QVERIFY(m1->layoutWidget()->checkSanity());
+    QCOMPARE(Frame::dbg_numFrames(), DockRegistry::self()->frames().size());
+
+    // Overlaying gets it back
+    m1->overlayOnSideBar(dw1);
+    QCOMPARE(dw1->dptr()->frame(), frame1);
+    QCOMPARE(factory->dbg_numPooledFrames(), 0);
+    QVERIFY(frame1->isOverlayed());
+    QVERIFY(DockRegistry::self()->frames().contains(frame1));
+    QCOMPARE(Frame::dbg_numFrames(), DockRegistry::self()->frames().size());
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    // Was a docked frame, it now paints its background as it's on top of the layout
+    QVERIFY(static_cast<FrameWidget *>(frame1)->autoFillBackground());
+#endif
+
+    m1->toggleOverlayOnSideBar(dw1);
+    QVERIFY(!dw1->isOverlayed());
+    QCOMPARE(factory->dbg_numPooledFrames(), 1);
+
+    m1->toggleOverlayOnSideBar(dw1);
+    QCOMPARE(dw1->dptr()->frame(), frame1);
+
+    m1->restoreFromSideBar(dw1);
+    QVERIFY(dw1->isInMainWindow());
+    QVERIFY(m1->layoutWidget()->checkSanity());
+    QVERIFY(!dw1->dptr()->frame()->isOverlayed());
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    // A former overlay doesn't keep filling its background once docked again
+    QVERIFY(!static_cast<FrameWidget *>(dw1->dptr()->frame())->autoFillBackground());
+#endif
+
+    factory->setFramePoolSize(0);
+    QCOMPARE(factory->dbg_numPooledFrames(), 0);
+}
+
+void TestDocks::tst_floatingWindowPool()
+{
+    // Tests that floating a dock widget uses a pre-created FloatingWindow, when a pool is set
+    EnsureTopLevelsDeleted e;
+    FrameworkWidgetFactory *factory = Config::self().frameworkWidgetFactory();
+
+    // The pool is usually filled before there's any dock widget, that mustn't delete the registry
+    QPointer<DockRegistry> registry = DockRegistry::self();
+    factory->setFloatingWindowPoolSize(1);
+    QTRY_COMPARE(factory->dbg_numPooledFloatingWindows(), 1);
+    QVERIFY(registry);
+    QCOMPARE(DockRegistry::self(), registry.data());
+
+    auto m1 = createMainWindow(QSize(1000, 1000), MainWindowOption_None, "MW1");
+    auto dw1 = new DockWidgetType(QStringLiteral("1"));
+    m1->addDockWidget(dw1, Location_OnBottom);
+
+    // Pooled windows are hidden and aren't known to the registry yet
+    const QVector<FloatingWindow *> floatingWindows = DockRegistry::self()->floatingWindows(/*includeBeingDeleted=*/ true);
+    QVERIFY(floatingWindows.isEmpty());
+
+    dw1->setFloating(true);
+    QVERIFY(dw1->isFloating());
+    QCOMPARE(factory->dbg_numPooledFloatingWindows(), 0);
+    FloatingWindow *fw = dw1->floatingWindow();
+    QVERIFY(fw);
+    QVERIFY(fw->isVisible());
+    QVERIFY(DockRegistry::self()->floatingWindows().contains(fw));
+    QCOMPARE(fw->dockWidgets().size(), 1);
+
+    // Refilled in the background
+    QTRY_COMPARE(factory->dbg_numPooledFloatingWindows(), 1);
+
+    // With more than one main window, the pooled window gets the floated frame's main window as parent
+    auto m2 = createMainWindow(QSize(1000, 1000), MainWindowOption_None, "MW2");
+    m2->setAffinities({ "af2" });
+    auto dw2 = new DockWidgetType(QStringLiteral("2"));
+    dw2->setAffinities({ "af2" });
+    m2->addDockWidget(dw2, Location_OnBottom);
+    QTest::qWait(500); // A refill attempt, which must not warn about not finding a main window
+    QCOMPARE(factory->dbg_numPooledFloatingWindows(), 1);
+
+    dw2->setFloating(true);
+    QCOMPARE(factory->dbg_numPooledFloatingWindows(), 0);
+    QCOMPARE(dw2->floatingWindow()->parentWidget(), static_cast<QWidget *>(m2.get()));
+
+    factory->setFloatingWindowPoolSize(0);
+    QCOMPARE(factory->dbg_numPooledFloatingWindows(), 0);
+}
+
+void TestDocks::tst_replayMovesSeparator()
+{
+    // Tests that replaying a recorded separator drag actually moves the separator
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None, "tst_replayMovesSeparator");
+    auto dock1 = createDockWidget("dock1", new QPushButton("one"));
+    auto dock2 = createDockWidget("dock2", new QPushButton("two"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    Separator *separator = m->multiSplitter()->separators().at(0);
+    const int oldPos = separator->position();
+    QWidget *separatorWidget = separator->asWidget()->asQWidget();
+    const QPoint pressPos = separatorWidget->mapToGlobal(separatorWidget->rect().center());
+
+    LayoutSaver saver;
+    const QByteArray layout = saver.serializeLayout();
+
+    auto eventMap = [&m] (qint64 time, QEvent::Type type, QPoint globalPos, Qt::MouseButton button, Qt::MouseButtons buttons) {
+        QVariantMap pos;
+        pos.insert("x", globalPos.x());
+        pos.insert("y", globalPos.y());
+        QVariantMap map;
+        map.insert("time", time);
+        map.insert("type", int(type));
+        map.insert("window", Debug::SessionRecorder::keyForWindow(m->windowHandle()));
+        map.insert("globalPos", pos);
+        map.insert("button", int(button));
+        map.insert("buttons", int(buttons));
+        map.insert("modifiers", 0);
+        return map;
+    };
+
+    const QPoint delta(50, 0);
+    QVariantList events;
+    events << eventMap(0, QEvent::MouseButtonPress, pressPos, Qt::LeftButton, Qt::LeftButton)
+           << eventMap(20, QEvent::MouseMove, pressPos + delta / 2, Qt::NoButton, Qt::LeftButton)
+           << eventMap(40, QEvent::MouseMove, pressPos + delta, Qt::NoButton, Qt::LeftButton)
+           << eventMap(60, QEvent::MouseButtonRelease, pressPos + delta, Qt::LeftButton, Qt::NoButton);
+
+    QVariantMap session;
+    session.insert("layout", QJsonDocument::fromJson(layout).toVariant());
+    session.insert("events", events);
+
+    QTemporaryDir dir;
+    const QString filename = dir.filePath(QStringLiteral("session.json"));
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QJsonDocument::fromVariant(session).toJson());
+    file.close();
+
+    Testing::Replayer replayer;
+    QVERIFY(replayer.load(filename));
+    QVERIFY(replayer.run());
+    Config::self().setMainWindowFactoryFunc(nullptr);
+
+    // Restoring the starting layout recreated the separators
+    separator = m->multiSplitter()->separators().at(0);
+    QCOMPARE(separator->position(), oldPos + delta.x());
+    QVERIFY(!Separator::isResizing());
+}
+
+void TestDocks::tst_appEventFilterForwardsEvents()
+{
+    // DockRegistry's event filter on qApp dispatches to the others. Tests that it still
+    // forwards the events to the resize handlers and the dock widgets.
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_MDI);
+    auto dock0 = createDockWidget("dock0", new MyWidget2(QSize(400, 400)));
+    qobject_cast<MDILayoutWidget *>(m->layoutWidget())->addDockWidget(dock0, QPoint(0, 0), {});
+
+    Frame *frame = dock0->DockWidgetBase::d->frame();
+    WidgetResizeHandler *handler = frame->resizeHandler();
+    QVERIFY(handler);
+    QVERIFY(!handler->isResizing());
+
+    // Press on the MDI frame's right border, its resize handler starts resizing
+    const int margin = WidgetResizeHandler::widgetResizeHandlerMargin();
+    const QPoint localPos(frame->QWidgetAdapter::width() - margin, frame->QWidgetAdapter::height() / 2);
+    const QPoint globalPos = frame->mapToGlobal(localPos);
+    QMouseEvent press(QEvent::MouseButtonPress, localPos, globalPos, Qt::LeftButton, Qt::LeftButton, {});
+    qApp->sendEvent(frame, &press);
+    QVERIFY(handler->isResizing());
+    QCOMPARE(DockRegistry::self()->frameInMDIResize(), frame);
+
+    QMouseEvent release(QEvent::MouseButtonRelease, localPos, globalPos, Qt::LeftButton, Qt::NoButton, {});
+    qApp->sendEvent(frame, &release);
+    QVERIFY(!handler->isResizing());
+    QVERIFY(!DockRegistry::self()->frameInMDIResize());
+
+    // (De)activating the window notifies its dock widgets, so title bars can update
+    QSignalSpy spy(dock0, &DockWidgetBase::windowActiveAboutToChange);
+    QEvent deactivate(QEvent::WindowDeactivate);
+    qApp->sendEvent(m.get(), &deactivate);
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(!spy.at(0).at(0).toBool());
+
+    QEvent activate(QEvent::WindowActivate);
+    qApp->sendEvent(m.get(), &activate);
+    QCOMPARE(spy.count(), 2);
+    QVERIFY(spy.at(1).at(0).toBool());
+
+    // Only the top-level is interesting, not each of its children
+    qApp->sendEvent(frame, &deactivate);
+    QCOMPARE(spy.count(), 2);
+}
+
 void TestDocks::tst_embeddedMainWindow()
 {
     EnsureTopLevelsDeleted e;
@@ -7125,6 +7451,554 @@ void TestDocks::tst_toggleAction()
     QCOMPARE(root->visibleCount_recursive(), 2);
 }
 
+void TestDocks::tst_actionsCreatedLazily()
+{
+    // Tests that the actions are only created when requested, but reflect the state from before
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget("dock1", new MyWidget2(QSize(400, 400)));
+    auto dock2 = createDockWidget("dock2", new MyWidget2(QSize(400, 400)));
+    m->addDockWidget(dock1, Location_OnLeft);
+
+    QVERIFY(dock1->findChildren<QAction *>(QString(), Qt::FindDirectChildrenOnly).isEmpty());
+    QVERIFY(dock1->isOpen());
+    QVERIFY(dock2->isFloating());
+
+    QSignalSpy floatingSpy(dock2, &DockWidgetBase::isFloatingChanged);
+    m->addDockWidget(dock2, Location_OnRight);
+    QVERIFY(!dock2->isFloating());
+    QVERIFY(!floatingSpy.isEmpty());
+    QCOMPARE(floatingSpy.last().first().toBool(), false);
+    floatingSpy.clear();
+
+    QAction *toggleAction = dock1->toggleAction();
+    QVERIFY(toggleAction->isChecked());
+    QCOMPARE(toggleAction->text(), dock1->title());
+    QCOMPARE(dock1->toggleAction(), toggleAction);
+
+    QAction *floatAction = dock2->floatAction();
+    QVERIFY(!floatAction->isChecked());
+
+    floatAction->toggle();
+    QVERIFY(dock2->isFloating());
+    QVERIFY(floatAction->isChecked());
+    QCOMPARE(floatingSpy.count(), 1);
+    QCOMPARE(floatingSpy.last().first().toBool(), true);
+
+    toggleAction->toggle();
+    QVERIFY(!dock1->isOpen());
+    QVERIFY(!toggleAction->isChecked());
+}
+
+void TestDocks::tst_isSuspended()
+{
+    // Tests that dock widgets the user can't see are suspended
+    EnsureTopLevelsDeleted e;
+    KDDockWidgets::Config::self().setFlags(KDDockWidgets::Config::Flag_SuspendHiddenDockWidgets);
+
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget("dock1", new MyWidget2(QSize(400, 400)));
+    auto dock2 = createDockWidget("dock2", new MyWidget2(QSize(400, 400)));
+    m->addDockWidget(dock1, Location_OnLeft);
+    QVERIFY(!dock1->isSuspended());
+
+    QSignalSpy spy(dock1, &DockWidgetBase::isSuspendedChanged);
+    dock1->addDockWidgetAsTab(dock2);
+    QVERIFY(dock1->isSuspended());
+    QVERIFY(!dock2->isSuspended());
+    QCOMPARE(spy.count(), 1);
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    QVERIFY(!dock1->widget()->updatesEnabled());
+    QVERIFY(dock2->widget()->updatesEnabled());
+#endif
+
+    dock1->setAsCurrentTab();
+    QVERIFY(!dock1->isSuspended());
+    QVERIFY(dock2->isSuspended());
+    QCOMPARE(spy.count(), 2);
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    QVERIFY(dock1->widget()->updatesEnabled());
+#endif
+
+#ifndef KDDOCKWIDGETS_QTWIDGETS
+    // Visibility the application set on its own guest survives a suspension
+    dock2->setAsCurrentTab();
+    dock2->widget()->setVisible(false);
+    dock1->setAsCurrentTab();
+    QVERIFY(dock2->isSuspended());
+    dock2->setAsCurrentTab();
+    QVERIFY(!dock2->isSuspended());
+    QVERIFY(!dock2->widget()->isVisible());
+    dock2->widget()->setVisible(true);
+#else
+    // Same for a guest the application disabled updates on
+    dock2->setAsCurrentTab();
+    dock2->widget()->setUpdatesEnabled(false);
+    dock1->setAsCurrentTab();
+    QVERIFY(dock2->isSuspended());
+    dock2->setAsCurrentTab();
+    QVERIFY(!dock2->isSuspended());
+    QVERIFY(!dock2->widget()->updatesEnabled());
+    dock2->widget()->setUpdatesEnabled(true);
+#endif
+
+    dock1->close();
+    QVERIFY(dock1->isSuspended());
+    QVERIFY(!dock2->isSuspended());
+
+    // A dock widget that was never shown is closed, so suspended too
+    auto dock3 = createDockWidget("dock3", new MyWidget2(QSize(400, 400)), {}, {}, /*show=*/ false);
+    QVERIFY(dock3->isSuspended());
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    QVERIFY(!dock3->widget()->updatesEnabled());
+#endif
+    m->addDockWidget(dock3, Location_OnRight);
+    QVERIFY(!dock3->isSuspended());
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    QVERIFY(dock3->widget()->updatesEnabled());
+
+    // A guest which starts with updates disabled keeps them disabled when resumed
+    auto guest4 = new MyWidget2(QSize(400, 400));
+    guest4->setUpdatesEnabled(false);
+    auto dock4 = createDockWidget("dock4", guest4, {}, {}, /*show=*/ false);
+    QVERIFY(dock4->isSuspended());
+    m->addDockWidget(dock4, Location_OnRight);
+    QVERIFY(!dock4->isSuspended());
+    QVERIFY(!guest4->updatesEnabled());
+#endif
+}
+
+void TestDocks::tst_frameWithManyTabs()
+{
+    // Tests that Frame's list of dock widgets stays in sync with the tabs
+    EnsureTopLevelsDeleted e;
+    KDDockWidgets::Config::self().setFlags(KDDockWidgets::Config::Flag_TabOverflowMenu);
+
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock0 = createDockWidget("dock0", new MyWidget2(QSize(100, 100)));
+    m->addDockWidget(dock0, Location_OnLeft);
+    Frame *frame = dock0->dptr()->frame();
+
+    const int numTabs = 50;
+    DockWidgetBase::List docks = { dock0 };
+    for (int i = 1; i < numTabs; ++i) {
+        auto dw = createDockWidget(QStringLiteral("dock%1").arg(i), new MyWidget2(QSize(100, 100)));
+        dock0->addDockWidgetAsTab(dw);
+        docks << dw;
+        QVERIFY(frame->containsDockWidget(dw));
+    }
+
+    QCOMPARE(frame->dockWidgetCount(), numTabs);
+    QCOMPARE(frame->dockWidgets(), docks);
+
+    // Closing a tab removes it from the list
+    DockWidgetBase *dock10 = docks.takeAt(10);
+    dock10->close();
+    QVERIFY(!frame->containsDockWidget(dock10));
+    QCOMPARE(frame->dockWidgets(), docks);
+
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    // QtQuick's TabBar doesn't support moving tabs yet
+    frame->tabWidget()->tabBar()->moveTabTo(0, 1);
+    docks.move(0, 1);
+    QCOMPARE(frame->dockWidgets(), docks);
+    QCOMPARE(frame->dockWidgetAt(1), dock0);
+
+    auto overflowButton = frame->findChild<QToolButton *>(QStringLiteral("tabOverflowButton"));
+    QVERIFY(overflowButton);
+
+    // Renaming a tab can make the tabs stop fitting too
+    auto m2 = createMainWindow(QSize(800, 500), MainWindowOption_None, "m2");
+    auto dockA = createDockWidget("dockA", new MyWidget2(QSize(100, 100)));
+    auto dockB = createDockWidget("dockB", new MyWidget2(QSize(100, 100)));
+    m2->addDockWidget(dockA, Location_OnLeft);
+    dockA->addDockWidgetAsTab(dockB);
+    auto overflowButton2 = dockA->dptr()->frame()->findChild<QToolButton *>(QStringLiteral("tabOverflowButton"));
+    QVERIFY(overflowButton2);
+    QVERIFY(!overflowButton2->isVisible());
+
+    dockB->setTitle(QString(300, QLatin1Char('x')));
+    QTRY_VERIFY(overflowButton2->isVisible());
+#endif
+
+    delete dock10;
+}
+
+void TestDocks::tst_titleUpdatesCoalesced()
+{
+    // Tests that many title changes only update the title bars once
+    EnsureTopLevelsDeleted e;
+    auto dw1 = new DockWidgetType(QStringLiteral("1"));
+    auto dw2 = new DockWidgetType(QStringLiteral("2"));
+    dw1->addDockWidgetAsTab(dw2);
+    dw1->setAsCurrentTab();
+    dw1->show();
+
+    Frame *frame = dw1->dptr()->frame();
+    FloatingWindow *fw = dw1->floatingWindow();
+    QVERIFY(fw);
+    QCOMPARE(frame->titleBar()->title(), QStringLiteral("1"));
+
+    QSignalSpy spy(frame->titleBar(), &TitleBar::titleChanged);
+    for (int i = 0; i < 100; ++i)
+        dw1->setTitle(QStringLiteral("Orders (%1)").arg(i));
+
+    // The tab is updated immediately, the title bars later
+    TabBar *tb = frame->tabWidget()->tabBar();
+    QCOMPARE(tb->text(0), QStringLiteral("Orders (99)"));
+    QCOMPARE(spy.count(), 0);
+
+    QTRY_COMPARE(frame->titleBar()->title(), QStringLiteral("Orders (99)"));
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(fw->titleBar()->title(), QStringLiteral("Orders (99)"));
+
+    // Changing the title of a non-current tab doesn't change the title bar
+    dw2->setTitle(QStringLiteral("other"));
+    QTest::qWait(50);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(tb->text(1), QStringLiteral("other"));
+
+    delete fw;
+
+    // A floating dock widget's window title is coalesced too
+    auto dw3 = new DockWidgetType(QStringLiteral("3"));
+    dw3->show();
+    FloatingWindow *fw3 = dw3->floatingWindow();
+    QVERIFY(fw3);
+    dw3->setTitle(QStringLiteral("a"));
+    dw3->setTitle(QStringLiteral("b"));
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    QCOMPARE(fw3->windowTitle(), QStringLiteral("3"));
+    QTRY_COMPARE(fw3->windowTitle(), QStringLiteral("b"));
+#endif
+    QTRY_COMPARE(fw3->titleBar()->title(), QStringLiteral("b"));
+
+    delete fw3;
+}
+
+void TestDocks::tst_floatingWindowForHandle()
+{
+    // Tests that DockRegistry finds floating windows by QWindow, before and after being exposed
+    EnsureTopLevelsDeleted e;
+    auto dw1 = new DockWidgetType(QStringLiteral("1"));
+    auto dw2 = new DockWidgetType(QStringLiteral("2"));
+    dw1->show();
+    dw2->show();
+
+    QPointer<FloatingWindow> fw1 = dw1->floatingWindow();
+    QPointer<FloatingWindow> fw2 = dw2->floatingWindow();
+    QVERIFY(fw1);
+    QVERIFY(fw2);
+
+    auto registry = DockRegistry::self();
+    QCOMPARE(registry->floatingWindowForHandle(fw1->windowHandle()), fw1.data());
+    QVERIFY(QTest::qWaitForWindowExposed(fw1->windowHandle()));
+    QVERIFY(QTest::qWaitForWindowExposed(fw2->windowHandle()));
+    QCOMPARE(registry->floatingWindowForHandle(fw1->windowHandle()), fw1.data());
+    QCOMPARE(registry->floatingWindowForHandle(fw2->windowHandle()), fw2.data());
+    QVERIFY(!registry->floatingWindowForHandle(static_cast<QWindow *>(nullptr)));
+
+    // Docking it into the other one unregisters it
+    dw2->addDockWidgetToContainingWindow(dw1, Location_OnLeft);
+    QTRY_VERIFY(!fw1);
+    QCOMPARE(dw1->floatingWindow(), fw2.data());
+    QCOMPARE(registry->floatingWindows().size(), 1);
+    QCOMPARE(registry->floatingWindowForHandle(fw2->windowHandle()), fw2.data());
+
+    delete fw2;
+}
+
+void TestDocks::tst_affinityMask()
+{
+    // Tests that interned affinities match the same way as the string lists
+    QVERIFY(AffinityMask().matches(AffinityMask()));
+    QVERIFY(AffinityMask({ QString() }).isEmpty());
+    QVERIFY(!AffinityMask({ "a" }).matches(AffinityMask()));
+    QVERIFY(AffinityMask({ "a", "b" }).matches(AffinityMask({ "c", "b" })));
+    QVERIFY(!AffinityMask({ "a", "b" }).matches(AffinityMask({ "c" })));
+    QCOMPARE(AffinityMask({ "a", "b" }), AffinityMask({ "b", "a" }));
+
+    // More names than fit in a single word
+    QStringList many;
+    for (int i = 0; i < 200; ++i)
+        many << QStringLiteral("affinity%1").arg(i);
+
+    const AffinityMask manyMask(many);
+    QVERIFY(manyMask.matches(AffinityMask({ QStringLiteral("affinity150") })));
+    QVERIFY(!AffinityMask({ QStringLiteral("affinity150") }).matches(AffinityMask({ QStringLiteral("affinity2") })));
+    QVERIFY(DockRegistry::self()->affinitiesMatch({ QStringLiteral("affinity199") }, many));
+    QVERIFY(!DockRegistry::self()->affinitiesMatch({ QStringLiteral("other") }, many));
+
+    // An empty name is the same as no affinity
+    QVERIFY(DockRegistry::self()->affinitiesMatch({ QString() }, {}));
+    QVERIFY(!DockRegistry::self()->affinitiesMatch({ QString() }, { QStringLiteral("affinity2") }));
+}
+
+void TestDocks::tst_titleBarIconsCached()
+{
+    // Tests that title bars share the same QIcon instead of building one each time
+    DefaultWidgetFactory factory;
+    const QIcon close1 = factory.iconForButtonType(TitleBarButtonType::Close, 1);
+    const QIcon close2 = factory.iconForButtonType(TitleBarButtonType::Close, 1);
+    QVERIFY(!close1.isNull());
+    QCOMPARE(close1.cacheKey(), close2.cacheKey());
+
+    // Different types get their own icon
+    QVERIFY(factory.iconForButtonType(TitleBarButtonType::Float, 1).cacheKey() != close1.cacheKey());
+
+    // The icon has all resolutions, so other DPRs, even ones no screen had before, reuse it
+    QCOMPARE(factory.iconForButtonType(TitleBarButtonType::Close, 2).cacheKey(), close1.cacheKey());
+    QCOMPARE(factory.iconForButtonType(TitleBarButtonType::Close, 3).cacheKey(), close1.cacheKey());
+
+    // Shared between factories too
+    DefaultWidgetFactory factory2;
+    QCOMPARE(factory2.iconForButtonType(TitleBarButtonType::Close, 1).cacheKey(), close1.cacheKey());
+}
+
+void TestDocks::tst_restoreTimings()
+{
+    // Tests the counters shown in the DebugWindow's performance page
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow();
+    auto dock1 = createDockWidget("dock1", new QPushButton("one"));
+    auto dock2 = createDockWidget("dock2", new QPushButton("two"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    // A closed dock widget, so every phase of the restore has work to do
+    auto dock3 = createDockWidget("dock3", new QPushButton("three"));
+    m->addDockWidget(dock3, Location_OnBottom);
+    dock3->close();
+
+    const quint64 relayoutsBefore = Layouting::ItemBoxContainer::dbg_numRelayouts();
+    MultiSplitter *layout = m->multiSplitter();
+    layout->setLayoutSize(layout->size() + QSize(10, 10));
+    QVERIFY(Layouting::ItemBoxContainer::dbg_numRelayouts() > relayoutsBefore);
+
+    LayoutSaver saver;
+    const QByteArray saved = saver.serializeLayout();
+    QElapsedTimer wallClock;
+    wallClock.start();
+    QVERIFY(saver.restoreLayout(saved));
+    const qint64 restoreNs = wallClock.nsecsElapsed();
+
+    const LayoutSaver::Private::RestoreTimings &timings = LayoutSaver::Private::s_lastRestoreTimings;
+    QVERIFY(timings.parse > 0);
+    QVERIFY(timings.clear > 0);
+    QVERIFY(timings.mainWindows > 0);
+    QVERIFY(timings.closedDockWidgets > 0);
+    QVERIFY(timings.placeholders > 0);
+
+    // The phases are measured inside restoreLayout(), they can't add up to more than it took
+    QVERIFY(timings.total() <= restoreNs);
+}
+
+void TestDocks::tst_tracer()
+{
+    // Tests that the span tracer records nothing unless enabled, and writes valid Chrome trace json
+    EnsureTopLevelsDeleted e;
+    QVERIFY(!Debug::Tracer::isEnabled());
+
+    QTemporaryDir dir;
+    const QString filename = dir.filePath(QStringLiteral("trace.json"));
+    Debug::Tracer::start(filename);
+    QVERIFY(Debug::Tracer::isEnabled());
+
+    auto m = createMainWindow();
+    auto dock1 = createDockWidget("dock1", new QPushButton("one"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    QVERIFY(Debug::Tracer::dbg_numSpans() > 0);
+
+    QVERIFY(Debug::Tracer::stop());
+    QVERIFY(!Debug::Tracer::isEnabled());
+
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QVariantList events = QJsonDocument::fromJson(file.readAll()).toVariant().toMap().value("traceEvents").toList();
+    QVERIFY(!events.isEmpty());
+
+    bool foundInsert = false;
+    for (const QVariant &ev : events) {
+        const QVariantMap map = ev.toMap();
+        QCOMPARE(map.value("ph").toString(), QStringLiteral("X"));
+        QVERIFY(map.value("dur").toDouble() >= 0);
+        foundInsert |= map.value("name").toString() == QLatin1String("insertItem");
+    }
+    QVERIFY(foundInsert);
+
+    // Disabled again, spans aren't recorded
+    const int numSpans = Debug::Tracer::dbg_numSpans();
+    auto dock2 = createDockWidget("dock2", new QPushButton("two"));
+    m->addDockWidget(dock2, Location_OnRight);
+    QCOMPARE(Debug::Tracer::dbg_numSpans(), numSpans);
+}
+
+void TestDocks::tst_memoryReport()
+{
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None, "mw1");
+    auto dock1 = createDockWidget("dock1", new QPushButton("one"));
+    auto dock2 = createDockWidget("dock2", new QPushButton("two"));
+    auto dock3 = createDockWidget("dock3", new QPushButton("three"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    m->addDockWidget(dock3, Location_OnBottom);
+
+    // dock2 leaves a placeholder behind, dock3 goes floating and also leaves one
+    dock2->close();
+    dock3->setFloating(true);
+
+    const DockRegistry::MemoryReport report = DockRegistry::self()->memoryReport();
+    QCOMPARE(report.dockWidgets, 3);
+    QCOMPARE(report.closedDockWidgets, 1);
+    QCOMPARE(report.danglingPlaceholderRefs, 0);
+
+    QCOMPARE(report.mainWindows.size(), 1);
+    const DockRegistry::LayoutMemoryUsage &mainWindowUsage = report.mainWindows.constFirst();
+    QCOMPARE(mainWindowUsage.name, QStringLiteral("mw1"));
+    QCOMPARE(mainWindowUsage.items, 3);
+    QCOMPARE(mainWindowUsage.placeholders, 2);
+    QCOMPARE(mainWindowUsage.frames, 1);
+    QCOMPARE(mainWindowUsage.dockWidgets, 1);
+    QCOMPARE(mainWindowUsage.placeholderRefs, 3);
+    QVERIFY(mainWindowUsage.containers >= 1);
+    QVERIFY(mainWindowUsage.estimatedBytes > 0);
+
+    QCOMPARE(report.floatingWindows.size(), 1);
+    const DockRegistry::LayoutMemoryUsage &floatingUsage = report.floatingWindows.constFirst();
+    QCOMPARE(floatingUsage.name, QStringLiteral("floating:dock3"));
+    QCOMPARE(floatingUsage.items, 1);
+    QCOMPARE(floatingUsage.placeholders, 0);
+    QCOMPARE(floatingUsage.placeholderRefs, 1);
+
+    QCOMPARE(report.placeholderRefs, 4);
+    QVERIFY(report.estimatedBytes > mainWindowUsage.estimatedBytes + floatingUsage.estimatedBytes);
+}
+
+void TestDocks::tst_placeholderCompaction()
+{
+    EnsureTopLevelsDeleted e;
+    Config::self().setMaxPlaceholdersPerLayout(1);
+
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget("dock1", new QPushButton("one"));
+    auto dock2 = createDockWidget("dock2", new QPushButton("two"));
+    auto dock3 = createDockWidget("dock3", new QPushButton("three"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    m->addDockWidget(dock3, Location_OnBottom);
+    MultiSplitter *layout = m->multiSplitter();
+
+    dock2->close();
+    dock3->close();
+    QCOMPARE(layout->placeholderCount(), 2);
+
+    // Compaction is deferred. The oldest placeholder goes away.
+    QTest::qWait(1);
+    QCOMPARE(layout->placeholderCount(), 1);
+    QCOMPARE(layout->count(), 2);
+    layout->checkSanity();
+
+    // dock2 lost its own placeholder, so it restores as a tab of its neighbour
+    dock2->show();
+    QCOMPARE(dock2->dptr()->frame(), dock1->dptr()->frame());
+
+    // dock3 still has its own
+    dock3->show();
+    QVERIFY(dock3->dptr()->frame() != dock1->dptr()->frame());
+    QCOMPARE(layout->placeholderCount(), 0);
+
+    // With Flag_CompactPlaceholdersOnSave, nothing happens until saving
+    Config::self().setFlags(Config::self().flags() | Config::Flag_CompactPlaceholdersOnSave);
+    dock2->close();
+    dock3->close();
+    QTest::qWait(1);
+    QCOMPARE(layout->placeholderCount(), 1); // dock2 was tabbed, its frame is still visible
+    dock1->close();
+    QTest::qWait(1);
+    QCOMPARE(layout->placeholderCount(), 2);
+
+    LayoutSaver saver;
+    saver.serializeLayout();
+    QCOMPARE(layout->placeholderCount(), 1);
+    layout->checkSanity();
+}
+
+void TestDocks::tst_placeholderAgeCompaction()
+{
+    // Tests that placeholders over the age limit are removed even if the layout stays idle
+    EnsureTopLevelsDeleted e;
+    Config::self().setMaxPlaceholderAge(200);
+
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget("dock1", new QPushButton("one"));
+    auto dock2 = createDockWidget("dock2", new QPushButton("two"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    MultiSplitter *layout = m->multiSplitter();
+
+    dock2->close();
+    QTest::qWait(1);
+    QCOMPARE(layout->placeholderCount(), 1); // Not old enough yet
+
+    QTRY_COMPARE(layout->placeholderCount(), 0);
+    layout->checkSanity();
+
+    dock2->show();
+    QCOMPARE(dock2->dptr()->frame(), dock1->dptr()->frame());
+}
+
+void TestDocks::tst_framesCached()
+{
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget("dock1", new QPushButton("one"));
+    auto dock2 = createDockWidget("dock2", new QPushButton("two"));
+    auto dock3 = createDockWidget("dock3", new QPushButton("three"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    MultiSplitter *layout = m->multiSplitter();
+
+    auto framesFromItems = [layout] {
+        Frame::List frames;
+        for (Layouting::Item *item : layout->items()) {
+            if (auto frame = static_cast<Frame *>(item->guestAsQObject()))
+                frames << frame;
+        }
+        return frames;
+    };
+
+    QCOMPARE(layout->frames(), framesFromItems());
+
+    // Nothing changed, so the list isn't rebuilt
+    QVERIFY(layout->frames().isSharedWith(layout->frames()));
+
+    m->addDockWidget(dock3, Location_OnTop);
+    QCOMPARE(layout->frames().size(), 3);
+    QCOMPARE(layout->frames(), framesFromItems());
+    QCOMPARE(layout->dockWidgets().size(), 3);
+
+    // Closing turns the item into a placeholder, which has no frame
+    dock2->close();
+    QTest::qWait(1);
+    QCOMPARE(layout->frames().size(), 2);
+    QCOMPARE(layout->frames(), framesFromItems());
+
+    dock2->show();
+    QCOMPARE(layout->frames().size(), 3);
+    QCOMPARE(layout->frames(), framesFromItems());
+
+    // Floating windows go through the same list
+    dock3->setFloating(true);
+    QCOMPARE(layout->frames().size(), 2);
+    QCOMPARE(layout->frames(), framesFromItems());
+    auto fw = dock3->floatingWindow();
+    QVERIFY(fw);
+    QCOMPARE(fw->frames().size(), 1);
+    QCOMPARE(fw->frames().constFirst(), dock3->dptr()->frame());
+    QCOMPARE(fw->dropArea()->dockWidgets(), DockWidgetBase::List({ dock3 }));
+}
+
 void TestDocks::tst_redocksToPreviousTabIndex()
 {
     // Checks that when reordering tabs with mouse, floating and redocking, they go back to their previous index
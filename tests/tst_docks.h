@@ -166,6 +166,7 @@ private Q_SLOTS:
     void tst_dockWidgetGetsFocusWhenDocked();
     void tst_setWidget();
     void tst_isFocused();
+    void tst_focusMovesBetweenFrames();
     void tst_floatingLastPosAfterDoubleClose();
     void tst_registry();
     void tst_honourGeometryOfHiddenWindow();
@@ -231,6 +232,19 @@ private Q_SLOTS:
     void tst_dock2FloatingWidgetsTabbed();
     void tst_deleteOnClose();
     void tst_toggleAction();
+    void tst_actionsCreatedLazily();
+    void tst_isSuspended();
+    void tst_frameWithManyTabs();
+    void tst_titleUpdatesCoalesced();
+    void tst_floatingWindowForHandle();
+    void tst_affinityMask();
+    void tst_titleBarIconsCached();
+    void tst_restoreTimings();
+    void tst_tracer();
+    void tst_memoryReport();
+    void tst_placeholderCompaction();
+    void tst_placeholderAgeCompaction();
+    void tst_framesCached();
     void tst_redocksToPreviousTabIndex();
 
     void tst_addMDIDockWidget();
@@ -256,6 +270,10 @@ private Q_SLOTS:
     void tst_floatRemovesFromSideBar();
     void tst_overlayedGeometryIsSaved();
     void tst_overlayCrash();
+    void tst_framePool();
+    void tst_floatingWindowPool();
+    void tst_replayMovesSeparator();
+    void tst_appEventFilterForwardsEvents();
 
     // And fix these
     void tst_floatingWindowDeleted();
@@ -274,5 +292,8 @@ private Q_SLOTS:
     void tst_complex();
 #else
     void tst_hoverShowsDropIndicators();
+    void tst_qmlComponentsCached();
+    void tst_separatorsArePlainItems();
+    void tst_frameGeometryChangedCoalesced();
 #endif
 };
@@ -195,6 +195,11 @@ private Q_SLOTS:
     void tst_maxSizeHonouredWhenAnotherRemoved();
     void tst_simplify();
     void tst_adjacentLayoutBorders();
+    void tst_minMaxSizeCacheInvalidated();
+    void tst_visibleChildrenCacheInvalidated();
+    void tst_coalescedSizeConstraints();
+    void tst_coalescedSeparatorMoves();
+    void tst_separatorDragBoundsRecomputed();
 };
 
 class MyHostWidget : public QWidget
@@ -272,6 +277,24 @@ static Item* createItem(QSize minSz = {}, QSize maxSz = {})
     return item;
 }
 
+/// @brief Adds the given flags to Config for the duration of a test, even if it fails midway
+struct ScopedConfigFlags
+{
+    explicit ScopedConfigFlags(Config::Flags flags)
+        : m_originalFlags(Config::self().flags())
+    {
+        Config::self().setFlags(m_originalFlags | flags);
+    }
+
+    ~ScopedConfigFlags()
+    {
+        Config::self().setFlags(m_originalFlags);
+    }
+
+    const Config::Flags m_originalFlags;
+    Q_DISABLE_COPY(ScopedConfigFlags)
+};
+
 static ItemBoxContainer* createRootWithSingleItem()
 {
     auto root = new ItemBoxContainer(new MyHostWidget());
@@ -1887,6 +1910,183 @@ void TestMultiSplitter::tst_adjacentLayoutBorders()
     QCOMPARE(borders4, LayoutBorderLocation_South);
 }
 
+void TestMultiSplitter::tst_minMaxSizeCacheInvalidated()
+{
+    // The container min/max sizes are cached, test they're invalidated when a nested child changes
+    auto root = createRoot();
+    Item *item1 = createItem();
+    Item *item2 = createItem();
+    Item *item3 = createItem();
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    ItemBoxContainer::insertItemRelativeTo(item3, item2, Location_OnBottom);
+
+    auto container = item2->parentBoxContainer();
+    QVERIFY(container && container != root.get());
+
+    auto expectedRootMinSize = [&] {
+        const int containerMinWidth = qMax(item2->minSize().width(), item3->minSize().width());
+        const int containerMinHeight = item2->minSize().height() + item3->minSize().height() + st;
+        return QSize(item1->minSize().width() + containerMinWidth + st,
+                     qMax(item1->minSize().height(), containerMinHeight));
+    };
+
+    QCOMPARE(root->minSize(), expectedRootMinSize());
+
+    auto w2 = static_cast<MyGuestWidget*>(item2->guestAsQObject());
+    w2->setMinSize(QSize(300, 300));
+    QCOMPARE(root->minSize(), expectedRootMinSize());
+    QCOMPARE(container->minSize(), QSize(item2->minSize().width(),
+                                         item2->minSize().height() + item3->minSize().height() + st));
+
+    // Hiding item3 shrinks the container's min size, and root's too
+    root->removeItem(item3, /*hardRemove=*/ false);
+    QCOMPARE(container->minSize(), item2->minSize());
+    QCOMPARE(root->minSize(), QSize(item1->minSize().width() + item2->minSize().width() + st,
+                                    qMax(item1->minSize().height(), item2->minSize().height())));
+
+    auto w1 = static_cast<MyGuestWidget*>(item1->guestAsQObject());
+    w1->setMaxSize(QSize(400, 400));
+    QCOMPARE(root->maxSizeHint().height(), qMax(item1->maxSizeHint().height(), root->minSize().height()));
+    QVERIFY(root->checkSanity());
+}
+
+void TestMultiSplitter::tst_visibleChildrenCacheInvalidated()
+{
+    // visibleChildren() is cached, test it follows placeholders and insertions/removals
+    auto root = createRoot();
+    Item *item1 = createItem();
+    Item *item2 = createItem();
+    Item *item3 = createItem();
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    root->insertItem(item3, Location_OnRight);
+    QCOMPARE(root->visibleChildren(), Item::List({ item1, item2, item3 }));
+    QCOMPARE(root->numVisibleChildren(), 3);
+
+    item2->turnIntoPlaceholder();
+    QCOMPARE(root->visibleChildren(), Item::List({ item1, item3 }));
+    QCOMPARE(root->numVisibleChildren(), 2);
+    QCOMPARE(root->numChildren(), 3);
+
+    root->restore(item2);
+    QCOMPARE(root->visibleChildren(), Item::List({ item1, item2, item3 }));
+
+    root->removeItem(item3);
+    QCOMPARE(root->visibleChildren(), Item::List({ item1, item2 }));
+    QCOMPARE(root->numVisibleChildren(), 2);
+
+    // A nested container is visible as long as one of its children is
+    Item *item4 = createItem();
+    ItemBoxContainer::insertItemRelativeTo(item4, item2, Location_OnBottom);
+    auto container = item2->parentBoxContainer();
+    QVERIFY(container && container != root.get());
+    QCOMPARE(root->visibleChildren(), Item::List({ item1, container }));
+
+    item2->turnIntoPlaceholder();
+    item4->turnIntoPlaceholder();
+    QCOMPARE(container->numVisibleChildren(), 0);
+    QCOMPARE(root->visibleChildren(), Item::List({ item1 }));
+    QVERIFY(root->checkSanity());
+}
+
+void TestMultiSplitter::tst_coalescedSizeConstraints()
+{
+    // With Flag::CoalescedSizeConstraints the guests' new min sizes are applied together,
+    // on the next event loop iteration
+    ScopedConfigFlags flags(Config::Flag::CoalescedSizeConstraints);
+
+    auto root = createRoot();
+    Item *item1 = createItem();
+    Item *item2 = createItem();
+    Item *item3 = createItem();
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    ItemBoxContainer::insertItemRelativeTo(item3, item2, Location_OnBottom);
+    QVERIFY(root->checkSanity());
+
+    const QSize oldMinSize = item2->minSize();
+    const QSize newMinSize = oldMinSize + QSize(100, 100);
+    for (Item *item : { item1, item2, item3 })
+        static_cast<MyGuestWidget*>(item->guestAsQObject())->setMinSize(newMinSize);
+
+    // Nothing changed yet
+    QCOMPARE(item2->minSize(), oldMinSize);
+
+    QTest::qWait(1);
+    for (Item *item : { item1, item2, item3 })
+        QCOMPARE(item->minSize(), newMinSize);
+
+    QCOMPARE(root->minSize(), QSize(2 * newMinSize.width() + st, 2 * newMinSize.height() + st));
+    QVERIFY(root->width() >= root->minSize().width());
+    QVERIFY(root->height() >= root->minSize().height());
+    QVERIFY(root->checkSanity());
+}
+
+void TestMultiSplitter::tst_coalescedSeparatorMoves()
+{
+    // With Flag::CoalescedResize the separator moves requested within the same frame
+    // result in a single resize, to the latest position
+    ScopedConfigFlags flags(Config::Flag::CoalescedResize);
+
+    auto root = createRoot();
+    Item *item1 = createItem();
+    Item *item2 = createItem();
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    QVERIFY(root->checkSanity());
+
+    Separator *separator = root->separators().constFirst();
+    const int oldPos = separator->position();
+    const int oldWidth = item1->width();
+    QSignalSpy spy(item1, &Item::widthChanged);
+
+    separator->schedulePendingMove(oldPos + 10);
+    separator->schedulePendingMove(oldPos + 20);
+    separator->schedulePendingMove(oldPos + 30);
+
+    // Nothing moved yet
+    QCOMPARE(separator->position(), oldPos);
+    QCOMPARE(item1->width(), oldWidth);
+
+    QTRY_COMPARE(separator->position(), oldPos + 30);
+    QCOMPARE(item1->width(), oldWidth + 30);
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(root->checkSanity());
+}
+
+void TestMultiSplitter::tst_separatorDragBoundsRecomputed()
+{
+    // The separator's range is memoized while dragging, but a neighbour's new min size
+    // must still be honoured
+    auto root = createRoot();
+    Item *item1 = createItem();
+    Item *item2 = createItem();
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    QVERIFY(root->checkSanity());
+
+    Separator *separator = root->separators().constFirst();
+    separator->onMousePress();
+    const int oldMinPos = separator->minPositionForDrag();
+    const int oldMaxPos = separator->maxPositionForDrag();
+    QVERIFY(oldMinPos < oldMaxPos);
+
+    auto guest2 = static_cast<MyGuestWidget*>(item2->guestAsQObject());
+    guest2->setMinSize(item2->minSize() + QSize(100, 0));
+    QCOMPARE(separator->minPositionForDrag(), oldMinPos);
+    QCOMPARE(separator->maxPositionForDrag(), oldMaxPos - 100);
+
+    auto guest1 = static_cast<MyGuestWidget*>(item1->guestAsQObject());
+    guest1->setMinSize(item1->minSize() + QSize(50, 0));
+    QCOMPARE(separator->minPositionForDrag(), oldMinPos + 50);
+    QCOMPARE(separator->maxPositionForDrag(), oldMaxPos - 100);
+
+    separator->onMouseReleased();
+    QVERIFY(!Separator::isResizing());
+    QVERIFY(root->checkSanity());
+}
+
 int main(int argc, char *argv[])
 {
     bool qpaPassed = false;
@@ -116,6 +116,8 @@ struct EnsureTopLevelsDeleted
 
         // Other cleanup, since we use this class everywhere
         Config::self().setDockWidgetFactoryFunc(nullptr);
+        Config::self().setMaxPlaceholdersPerLayout(0);
+        Config::self().setMaxPlaceholderAge(0);
         Config::self().setInternalFlags(m_originalInternalFlags);
         Config::self().setFlags(m_originalFlags);
         Config::self().setSeparatorThickness(m_originalSeparatorThickness);